@@ -3,9 +3,11 @@
 void canvas(nk::context& ctx, nk_user_font& font)
 {
 	/* use the complete window space and set background */
-	auto over1 = ctx.style_override_scoped(&nk_style::window, &nk_style_window::padding, {0, 0});
-	auto over2 = ctx.style_override_scoped(&nk_style::window, &nk_style_window::spacing, {0, 0});
-	auto over3 = ctx.style_override_scoped(&nk_style::window, &nk_style_window::fixed_background, nk::style_item_color({250, 250, 250}));
+	static const auto patch = nk::make_style_patch(
+		nk::style_field(&nk_style::window, &nk_style_window::padding, {0, 0}),
+		nk::style_field(&nk_style::window, &nk_style_window::spacing, {0, 0}),
+		nk::style_field(&nk_style::window, &nk_style_window::fixed_background, nk::style_item_color({250, 250, 250})));
+	auto over = ctx.style_patch_scoped(patch);
 
 	/* create/update window and set position + size */
 	auto win = ctx.window_scoped("Canvas", {10, 10, 500, 550},
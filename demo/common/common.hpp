@@ -36,6 +36,11 @@ void canvas(nk::context& ctx, nk_user_font& font);
 // from node_editor.c
 bool node_editor(nk::context& ctx);
 
+// Nukleus-specific diagnostics
+void latency_overlay(nk::context& ctx, nk::latency_tracker& tracker);
+void window_cost_overlay(nk::context& ctx, const nk::window_profiler& profiler);
+void draw_stats_overlay(nk::context& ctx, const nk::convert_stats& stats);
+
 // from main function of demos
 inline void demo_window(nk::context& ctx, nk::colorf& bg)
 {
@@ -0,0 +1,232 @@
+#include "common/common.hpp"
+
+#include <algorithm>
+
+namespace {
+
+const char* stage_name(nk::latency_stage stage)
+{
+	switch (stage) {
+		case nk::latency_stage::input:   return "input";
+		case nk::latency_stage::build:   return "build";
+		case nk::latency_stage::convert: return "convert";
+		case nk::latency_stage::submit:  return "submit";
+		case nk::latency_stage::present: return "present";
+	}
+	return "";
+}
+
+double to_ms(double seconds)
+{
+	return seconds * 1000;
+}
+
+template <typename T>
+void stat_row(nk::window& win, const char* name, T value)
+{
+	win.label(name, nk::text_alignment_flags::middle_left);
+	win.label_format(nk::text_alignment_flags::middle_right, "{}", value);
+}
+
+void kib_row(nk::window& win, const char* name, nk_size bytes)
+{
+	win.label(name, nk::text_alignment_flags::middle_left);
+	win.label_format(nk::text_alignment_flags::middle_right, "{:.1}", static_cast<double>(bytes) / 1024);
+}
+
+const char* command_type_name(int type)
+{
+	switch (type) {
+		case NK_COMMAND_NOP:              return "nop";
+		case NK_COMMAND_SCISSOR:          return "scissor";
+		case NK_COMMAND_LINE:             return "line";
+		case NK_COMMAND_CURVE:            return "curve";
+		case NK_COMMAND_RECT:             return "rect";
+		case NK_COMMAND_RECT_FILLED:      return "rect filled";
+		case NK_COMMAND_RECT_MULTI_COLOR: return "rect multi color";
+		case NK_COMMAND_CIRCLE:           return "circle";
+		case NK_COMMAND_CIRCLE_FILLED:    return "circle filled";
+		case NK_COMMAND_ARC:              return "arc";
+		case NK_COMMAND_ARC_FILLED:       return "arc filled";
+		case NK_COMMAND_TRIANGLE:         return "triangle";
+		case NK_COMMAND_TRIANGLE_FILLED:  return "triangle filled";
+		case NK_COMMAND_POLYGON:          return "polygon";
+		case NK_COMMAND_POLYGON_FILLED:   return "polygon filled";
+		case NK_COMMAND_POLYLINE:         return "polyline";
+		case NK_COMMAND_TEXT:             return "text";
+		case NK_COMMAND_IMAGE:            return "image";
+		case NK_COMMAND_CUSTOM:           return "custom";
+	}
+	return "";
+}
+
+void command_types_tooltip(nk::window& win, const nk::window_cost& cost)
+{
+	auto tooltip = win.tooltip_scoped(180);
+	if (!tooltip)
+		return;
+
+	win.layout_row_dynamic(16, 2);
+	for (int i = 0; i < nk::window_cost::command_type_count; ++i) {
+		if (cost.commands_by_type[i] == 0)
+			continue;
+
+		win.label(command_type_name(i), nk::text_alignment_flags::middle_left);
+		win.label_format(nk::text_alignment_flags::middle_right, "{}", cost.commands_by_type[i]);
+	}
+}
+
+}
+
+void latency_overlay(nk::context& ctx, nk::latency_tracker& tracker)
+{
+	auto win = ctx.window_titled_scoped("Latency", "Input latency", {820, 10, 370, 330},
+		nk::window_flags::border | nk::window_flags::movable | nk::window_flags::scalable
+		| nk::window_flags::minimizable | nk::window_flags::title);
+	if (!win)
+		return;
+
+	const nk::latency_histogram& presented = tracker.get_histogram(nk::latency_stage::present);
+	win.layout_row_dynamic(20, 1);
+	win.label_format(nk::text_alignment_flags::middle_left, "measured frames: {}", presented.get_count());
+
+	/* latency from the earliest input event of a frame to each stage */
+	const float ratios[] = {0.25f, 0.15f, 0.15f, 0.15f, 0.15f, 0.15f};
+	win.layout_row_dynamic(20, ratios);
+	const char* const headers[] = {"ms", "last", "mean", "p50", "p99", "max"};
+	for (const char* header : headers)
+		win.label(header, nk::text_alignment_flags::middle_right);
+
+	for (int i = 0; i < nk::latency_stage_count; ++i) {
+		const auto stage = static_cast<nk::latency_stage>(i);
+		const nk::latency_histogram& h = tracker.get_histogram(stage);
+		win.label(stage_name(stage), nk::text_alignment_flags::middle_right);
+		if (h.get_count() == 0) {
+			win.spacing(5);
+			continue;
+		}
+
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.1}", to_ms(tracker.get_last(stage)));
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.1}", to_ms(h.get_mean()));
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.0}", to_ms(h.get_percentile(0.5)));
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.0}", to_ms(h.get_percentile(0.99)));
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.1}", to_ms(h.get_max()));
+	}
+
+	/* input-to-present histogram */
+	int highest = 1;
+	for (int i = 0; i < nk::latency_histogram::bucket_count; ++i)
+		highest = presented.get_bucket(i) > highest ? presented.get_bucket(i) : highest;
+
+	win.layout_row_dynamic(20, 1);
+	win.label_format(nk::text_alignment_flags::middle_left, "input to present, {:.0} ms per column, last is overflow",
+		to_ms(presented.get_bucket_width()));
+	win.layout_row_dynamic(80, 1);
+	if (auto chart = win.chart_scoped(nk::chart_type::columns, nk::latency_histogram::bucket_count, 0, static_cast<float>(highest))) {
+		for (int i = 0; i < nk::latency_histogram::bucket_count; ++i)
+			(void) chart.push(static_cast<float>(presented.get_bucket(i)));
+	}
+
+	win.layout_row_dynamic(25, 1);
+	if (win.button_label("Reset"))
+		tracker.reset();
+}
+
+void window_cost_overlay(nk::context& ctx, const nk::window_profiler& profiler)
+{
+	/* shown costs are a copy - live values would change the window (and request a new frame) every frame */
+	constexpr int max_windows = 32;
+	static nk::window_cost costs[max_windows];
+	static int count = 0;
+	static bool live = false;
+
+	auto win = ctx.window_titled_scoped("Window costs", "Window costs", {820, 350, 370, 300},
+		nk::window_flags::border | nk::window_flags::movable | nk::window_flags::scalable
+		| nk::window_flags::minimizable | nk::window_flags::title);
+	if (!win)
+		return;
+
+	win.layout_row_dynamic(25, 2);
+	const bool capture = win.button_label("Capture");
+	(void) win.checkbox_label_in_place("live", live);
+	if (capture || live) {
+		count = std::min(profiler.get_window_count(), max_windows);
+		for (int i = 0; i < count; ++i)
+			costs[i] = profiler.get_cost(i);
+
+		/* most expensive windows first */
+		std::sort(costs, costs + count, [](const nk::window_cost& lhs, const nk::window_cost& rhs) {
+			return lhs.build_seconds > rhs.build_seconds;
+		});
+	}
+
+	win.layout_row_dynamic(20, 1);
+	win.label("hover a window name for its commands by type", nk::text_alignment_flags::middle_left);
+
+	const float ratios[] = {0.3f, 0.14f, 0.14f, 0.14f, 0.14f, 0.14f};
+	win.layout_row_dynamic(20, ratios);
+	const char* const headers[] = {"window", "ms", "cmds", "KiB", "vtx", "idx"};
+	for (const char* header : headers)
+		win.label(header, nk::text_alignment_flags::middle_right);
+
+	const nk::window_cost* hovered = nullptr;
+	for (int i = 0; i < count; ++i) {
+		const nk::window_cost& cost = costs[i];
+		if (nk_input_is_mouse_hovering_rect(&ctx.get_input(), win.widget_bounds()))
+			hovered = &cost;
+
+		win.label(cost.name, nk::text_alignment_flags::middle_right);
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.2}", to_ms(cost.build_seconds));
+		win.label_format(nk::text_alignment_flags::middle_right, "{}", cost.command_count);
+		win.label_format(nk::text_alignment_flags::middle_right, "{:.1}", static_cast<double>(cost.command_bytes) / 1024);
+		if (profiler.is_counting_vertices()) {
+			win.label_format(nk::text_alignment_flags::middle_right, "{}", cost.vertex_count);
+			win.label_format(nk::text_alignment_flags::middle_right, "{}", cost.element_count);
+		}
+		else {
+			win.spacing(2);
+		}
+	}
+
+	if (hovered)
+		command_types_tooltip(win, *hovered);
+}
+
+void draw_stats_overlay(nk::context& ctx, const nk::convert_stats& stats)
+{
+	/* shown statistics are a copy for the same reason as in window_cost_overlay */
+	static nk::convert_stats shown;
+	static bool live = false;
+
+	auto win = ctx.window_titled_scoped("Draw statistics", "Draw statistics", {820, 660, 370, 140},
+		nk::window_flags::border | nk::window_flags::movable | nk::window_flags::scalable
+		| nk::window_flags::minimizable | nk::window_flags::title);
+	if (!win)
+		return;
+
+	win.layout_row_dynamic(25, 2);
+	const bool capture = win.button_label("Capture");
+	(void) win.checkbox_label_in_place("live", live);
+	if (capture || live)
+		shown = stats;
+
+	win.layout_row_dynamic(20, 2);
+	win.label("result", nk::text_alignment_flags::middle_left);
+	win.label(shown.result == nk::convert_result_flags::success ? "success" : "buffer full", nk::text_alignment_flags::middle_right);
+	stat_row(win, "draw commands", shown.draw_command_count);
+	stat_row(win, "textures", shown.texture_count);
+	stat_row(win, "scissor changes", shown.scissor_change_count);
+	stat_row(win, "vertices", shown.vertex_count);
+	stat_row(win, "indices", shown.element_count);
+	kib_row(win, "command KiB", shown.command_bytes);
+	kib_row(win, "vertex KiB", shown.vertex_bytes);
+	kib_row(win, "index KiB", shown.element_bytes);
+	stat_row(win, "triangle area px", static_cast<long long>(shown.triangle_area));
+	if (shown.covered_area_computed) {
+		stat_row(win, "covered area px", static_cast<long long>(shown.covered_area));
+		stat_row(win, "overdraw px (estimate)", static_cast<long long>(shown.overdraw_area));
+	} else {
+		win.label("covered area px", nk::text_alignment_flags::middle_left);
+		win.label("too many windows", nk::text_alignment_flags::middle_right);
+	}
+}
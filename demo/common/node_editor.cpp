@@ -7,289 +7,251 @@
  * not have connectors on the right position of the property that it links.
  * This is mainly done out of laziness and could be implemented as well but
  * requires calculating the position of all rows and add connectors.
- * In addition adding and removing nodes is quite limited at the
- * moment since it is based on a simple fixed array. If this is to be converted
- * into something more serious it is probably best to extend it.
  */
 
+// Unlike the original, this version is meant to scale to large graphs (10 000+ nodes), see common/node_graph.hpp.
+// Only nodes and links intersecting the viewport are built and drawn, background grid is drawn
+// as 2 polylines instead of 1 line command per grid line.
+// Use "Stress test" in the contextual menu to populate the editor and compare frame build times.
+
 #include "common/common.hpp"
+#include "common/node_graph.hpp"
 
-#include <list>
+#include <chrono>
 #include <vector>
-#include <string>
 #include <math.h>
+#include <stdio.h>
 
-struct node {
-	int id;
-	std::string name;
-	nk::rect<float> bounds;
-	float value;
-	nk::color color;
-	int input_count;
-	int output_count;
-};
-
-struct node_link {
-	int input_id;
-	int input_slot;
-	int output_id;
-	int output_slot;
-	nk::vec2<float> in;
-	nk::vec2<float> out;
-};
+namespace {
 
 struct node_linking {
-	int active = 0;
-	node* nd = nullptr;
-	int input_id = 0;
+	bool active = false;
+	node_handle nd = -1;
 	int input_slot = 0;
 };
 
-struct node_editor {
-	std::list<node> nodes;
-	std::vector<node_link> links;
+struct node_editor_state {
+	node_editor_state()
+	{
+		graph.add("Source", {40, 10, 180, 220}, nk::color(255, 0, 0), 0, 1);
+		graph.add("Source", {40, 260, 180, 220}, nk::color(0, 255, 0), 0, 1);
+		graph.add("Combine", {400, 100, 180, 220}, nk::color(0, 0, 255), 2, 2);
+		graph.link(0, 0, 2, 0);
+		graph.link(1, 0, 2, 1);
+	}
 
-	nk::rect<float> bounds;
-	node* selected = nullptr; // set but not used for anything
+	node_graph graph;
+	node_handle selected = -1; // set but not used for anything
 	bool show_grid = true;
 	nk::vec2<float> scrolling;
 	node_linking linking{};
 
-	node_editor()
-	{
-		add("Source", {40, 10, 180, 220}, nk::color(255, 0, 0), 0, 1);
-		add("Source", {40, 260, 180, 220}, nk::color(0, 255, 0), 0, 1);
-		add("Combine", {400, 100, 180, 220}, nk::color(0,0,255), 2, 2);
-		link(0, 0, 2, 0);
-		link(1, 0, 2, 1);
-	}
-
-	node* find(int id)
-	{
-		for (auto& node : nodes)
-			if (node.id == id)
-				return &node;
+	// statistics of the last view change
+	double build_time_ms = 0;
+	int visible_nodes = 0;
+	int visible_links = 0;
+};
 
-		return nullptr;
-	}
+node_editor_state editor;
 
-	void push(node n)
-	{
-		nodes.push_back(nk::move(n));
-	}
-
-	void pop()
-	{
-		NUKLEUS_ASSERT(!nodes.empty());
-		nodes.pop_back();
+void draw_grid(nk::canvas& canvas, nk::rect<float> area, nk::rect<float> clip, nk::vec2<float> scrolling)
+{
+	const float grid_size = 32.0f;
+	const nk::color grid_color(50, 50, 50);
+	static std::vector<float> points;
+
+	// Lines are joined into a zigzag polyline. Joints are placed outside of the clip
+	// rectangle so that the connecting segments are never visible.
+	const float top = clip.y - 1.0f;
+	const float bottom = clip.y + clip.h + 1.0f;
+	points.clear();
+	for (float x = fmodf(area.x - scrolling.x, grid_size); x < area.w; x += grid_size) {
+		const bool down = (points.size() / 4) % 2 == 0;
+		points.insert(points.end(), {x + area.x, down ? top : bottom, x + area.x, down ? bottom : top});
 	}
-
-	void add(const char* name, nk::rect<float> bounds, nk::color col, int in_count, int out_count)
-	{
-		static int ids = 0;
-		node nd;
-		nd.id = ids++;
-		nd.value = 0;
-		nd.color = nk::color(255, 0, 0);
-		nd.input_count = in_count;
-		nd.output_count = out_count;
-		nd.color = col;
-		nd.bounds = bounds;
-		nd.name = name;
-		push(nk::move(nd));
+	if (!points.empty())
+		canvas.stroke_polyline(points.data(), static_cast<int>(points.size() / 2), 1.0f, grid_color);
+
+	const float left = clip.x - 1.0f;
+	const float right = clip.x + clip.w + 1.0f;
+	points.clear();
+	for (float y = fmodf(area.y - scrolling.y, grid_size); y < area.h; y += grid_size) {
+		const bool forward = (points.size() / 4) % 2 == 0;
+		points.insert(points.end(), {forward ? left : right, y + area.y, forward ? right : left, y + area.y});
 	}
+	if (!points.empty())
+		canvas.stroke_polyline(points.data(), static_cast<int>(points.size() / 2), 1.0f, grid_color);
+}
 
-	void link(int in_id, int in_slot, int out_id, int out_slot)
-	{
-		node_link link;
-		link.input_id = in_id;
-		link.input_slot = in_slot;
-		link.output_id = out_id;
-		link.output_slot = out_slot;
-		links.push_back(link);
-	}
+void draw_curve(nk::canvas& canvas, nk::vec2<float> l0, nk::vec2<float> l1)
+{
+	canvas.stroke_curve(
+		l0.x, l0.y, l0.x + curve_tangent, l0.y, l1.x - curve_tangent, l1.y, l1.x, l1.y, 1.0f, nk::color(100, 100, 100));
+}
 
-};
-static struct node_editor editor;
+}
 
 bool node_editor(nk::context& ctx)
 {
+	const auto frame_start = std::chrono::steady_clock::now();
+	const int last_visible_nodes = editor.visible_nodes;
+	const int last_visible_links = editor.visible_links;
+	bool scrolled = false;
+
 	if (auto win = ctx.window_scoped("NodeEdit", {0, 0, 800, 600},
 		nk::window_flags::border | nk::window_flags::no_scrollbar | nk::window_flags::movable | nk::window_flags::closable))
 	{
 		/* allocate complete window space */
 		auto canvas = win.get_canvas();
 		auto total_space = win.get_content_region();
+		const nk::rect<float> clip = win.get_panel().clip;
+		const nk_mouse& mouse = ctx.get_input().mouse;
 
 		{
-			auto layout_space = win.layout_space_static_scoped(total_space.h, editor.nodes.size());
-			auto size = layout_space.bounds();
-
-			// I could not understand this part from original demo. It's not about C89 start-of-scope variables.
-			// The panel object is used in multiple API calls in a quite large scope but initialized later.
-			// Initially I just initialized it earlier, in a larger scope but then I was getting a different object.
-			// Seems like this demo implementation relies on reuse of some internal state that is accessible
-			// only at particular moment in time. There is no documentation or any comment how it works. Very ugly.
-			nk_panel* node = nullptr;
-
-			if (editor.show_grid) {
-				/* display grid */
-				const float grid_size = 32.0f;
-				const nk::color grid_color(50, 50, 50);
-				for (float x = fmod(size.x - editor.scrolling.x, grid_size); x < size.w; x += grid_size)
-					canvas.stroke_line(x+size.x, size.y, x+size.x, size.y+size.h, 1.0f, grid_color);
-				for (float y = fmod(size.y - editor.scrolling.y, grid_size); y < size.h; y += grid_size)
-					canvas.stroke_line(size.x, y+size.y, size.x+size.w, y+size.y, 1.0f, grid_color);
+			auto layout_space = win.layout_space_static_scoped(total_space.h, static_cast<int>(editor.graph.nodes().size()));
+			const auto size = layout_space.bounds();
+			// screen position of editor space origin
+			const nk::vec2<float> origin = layout_space.to_screen({-editor.scrolling.x, -editor.scrolling.y});
+			const auto to_screen = [&](nk::vec2<float> v) { return nk::vec2<float>(v.x + origin.x, v.y + origin.y); };
+			const nk::vec2<float> mouse_local(mouse.pos.x - origin.x, mouse.pos.y - origin.y);
+			const nk::rect<float> viewport(editor.scrolling.x, editor.scrolling.y, size.w, size.h);
+
+			if (editor.show_grid)
+				draw_grid(canvas, size, clip, editor.scrolling);
+
+			/* node selection, bring to front and start of linking process */
+			if (ctx.input_is_mouse_pressed(nk::buttons::left) && ctx.input_is_mouse_hovering_rect(size)) {
+				editor.selected = editor.graph.pick(mouse_local);
+				if (editor.selected >= 0) {
+					editor.graph.bring_to_front(editor.selected);
+
+					const node& nd = editor.graph.get(editor.selected);
+					for (int n = 0; n < nd.output_count; ++n) {
+						if (contains(connector_rect(output_connector(nd, n)), mouse_local)) {
+							editor.linking.active = true;
+							editor.linking.nd = editor.selected;
+							editor.linking.input_slot = n;
+						}
+					}
+				}
 			}
 
-			/* execute each node as a movable group */
-			auto updated = editor.nodes.end();
-			for (auto it = editor.nodes.begin(); it != editor.nodes.end(); ++it) {
+			/* execute each visible node as a movable group */
+			const auto& visible = editor.graph.visible_nodes(viewport);
+			for (node_handle h : visible) {
+				node& nd = editor.graph.get(h);
 				/* calculate scrolled node window position and size */
-				layout_space.push({it->bounds.x - editor.scrolling.x, it->bounds.y - editor.scrolling.y, it->bounds.w, it->bounds.h});
+				layout_space.push({nd.bounds.x - editor.scrolling.x, nd.bounds.y - editor.scrolling.y, nd.bounds.w, nd.bounds.h});
 
 				/* execute node window */
-				if (auto group = layout_space.group_scoped(
-					it->name.c_str(),
+				if (auto group = layout_space.group_titled_scoped(
+					nd.id.c_str(),
+					nd.name.c_str(),
 					nk::panel_flags::movable|nk::panel_flags::no_scrollbar|nk::panel_flags::border|nk::panel_flags::title))
 				{
-					// I replicated the same point where the panel object is obtained.
-					// If this call is moved elsewhere, a different object is obtained.
-					node = &win.get_panel();
-
-					/* always have last selected node on top */
-					if (ctx.input_mouse_clicked(nk::buttons::left, node->bounds) &&
-						(!(it != editor.nodes.begin() && ctx.input_mouse_clicked(nk::buttons::left,
-						layout_space.rect_to_screen(node->bounds)))) &&
-						editor.nodes.end() != std::next(it))
-					{
-						updated = it;
-					}
+					// panel of the group, only accessible while it is being built
+					const nk::rect<float> panel_bounds = win.get_panel().bounds;
 
 					/* ================= NODE CONTENT =====================*/
 					win.layout_row_dynamic(25, 1);
-					(void) win.button_color(it->color);
-					it->color.r = static_cast<nk_byte>(win.property("#R:", 0, it->color.r, 255, 1, 1));
-					it->color.g = static_cast<nk_byte>(win.property("#G:", 0, it->color.g, 255, 1, 1));
-					it->color.b = static_cast<nk_byte>(win.property("#B:", 0, it->color.b, 255, 1, 1));
-					it->color.a = static_cast<nk_byte>(win.property("#A:", 0, it->color.a, 255, 1, 1));
+					(void) win.button_color(nd.color);
+					nd.color.r = static_cast<nk_byte>(win.property("#R:", 0, nd.color.r, 255, 1, 1));
+					nd.color.g = static_cast<nk_byte>(win.property("#G:", 0, nd.color.g, 255, 1, 1));
+					nd.color.b = static_cast<nk_byte>(win.property("#B:", 0, nd.color.b, 255, 1, 1));
+					nd.color.a = static_cast<nk_byte>(win.property("#A:", 0, nd.color.a, 255, 1, 1));
 					/* ====================================================*/
-				}
-				{
-					/* node connector and linking */
-					auto bounds = layout_space.rect_to_local(node->bounds);
+
+					/* update position (group could have been dragged) */
+					auto bounds = layout_space.rect_to_local(panel_bounds);
 					bounds.x += editor.scrolling.x;
 					bounds.y += editor.scrolling.y;
-					it->bounds = bounds;
-
-					/* output connector */
-					float space = node->bounds.h / static_cast<float>(it->output_count + 1);
-					for (int n = 0; n < it->output_count; ++n) {
-						nk::rect<float> circle(
-							node->bounds.x + node->bounds.w - 4,
-							node->bounds.y + space * static_cast<float>(n + 1),
-							8,
-							8
-						);
-						canvas.fill_circle(circle, {100, 100, 100});
-
-						/* start linking process */
-						if (ctx.input_has_mouse_click_down_in_rect(nk::buttons::left, circle, nk_true)) {
-							editor.linking.active = nk_true;
-							editor.linking.nd = &*it;
-							editor.linking.input_id = it->id;
-							editor.linking.input_slot = n;
-						}
+					editor.graph.move(h, bounds);
+				}
 
-						/* draw curve from linked node slot to mouse position */
-						if (editor.linking.active && editor.linking.nd == &*it && editor.linking.input_slot == n) {
-							nk::vec2<float> l0(circle.x + 3, circle.y + 3);
-							nk::vec2<float> l1 = ctx.get_input().mouse.pos;
-							canvas.stroke_curve(l0.x, l0.y, l0.x + 50.0f, l0.y, l1.x - 50.0f, l1.y, l1.x, l1.y, 1.0f, nk::color(100, 100, 100));
+				/* node connectors */
+				for (int n = 0; n < nd.output_count; ++n)
+					canvas.fill_circle(connector_rect(to_screen(output_connector(nd, n))), nk::color(100, 100, 100));
+				for (int n = 0; n < nd.input_count; ++n)
+					canvas.fill_circle(connector_rect(to_screen(input_connector(nd, n))), nk::color(100, 100, 100));
+			}
+			editor.visible_nodes = static_cast<int>(visible.size());
+
+			if (editor.linking.active) {
+				/* draw curve from linked node slot to mouse position */
+				const node& from = editor.graph.get(editor.linking.nd);
+				draw_curve(canvas, to_screen(output_connector(from, editor.linking.input_slot)), mouse.pos);
+
+				/* finish linking process */
+				if (ctx.input_is_mouse_released(nk::buttons::left)) {
+					editor.linking.active = false;
+
+					const node_handle target = editor.graph.pick(mouse_local);
+					bool linked = false;
+					if (target >= 0 && target != editor.linking.nd) {
+						const node& to = editor.graph.get(target);
+						for (int n = 0; n < to.input_count; ++n) {
+							if (contains(connector_rect(input_connector(to, n)), mouse_local)) {
+								editor.graph.link(editor.linking.nd, editor.linking.input_slot, target, n);
+								linked = true;
+								break;
+							}
 						}
 					}
 
-					/* input connector */
-					space = node->bounds.h / static_cast<float>(it->input_count + 1);
-					for (int n = 0; n < it->input_count; ++n) {
-						nk::rect<float> circle(
-							node->bounds.x - 4,
-							node->bounds.y + space * static_cast<float>(n + 1),
-							8,
-							8
-						);
-						canvas.fill_circle(circle, nk::color(100, 100, 100));
-						if (ctx.input_is_mouse_released(nk::buttons::left) &&
-							ctx.input_is_mouse_hovering_rect(circle) &&
-							editor.linking.active && editor.linking.nd != &*it) {
-							editor.linking.active = nk_false;
-							editor.link(editor.linking.input_id, editor.linking.input_slot, it->id, n);
-						}
-					}
+					editor.linking.nd = -1;
+					if (!linked)
+						fprintf(stdout, "linking failed\n");
 				}
 			}
 
-			/* reset linking connection */
-			if (editor.linking.active && ctx.input_is_mouse_released(nk::buttons::left)) {
-				editor.linking.active = false;
-				editor.linking.nd = nullptr;
-				fprintf(stdout, "linking failed\n");
-			}
-
-			/* draw each link */
-			for (const node_link& link : editor.links) {
-				struct node* ni = editor.find(link.input_id);
-				struct node* no = editor.find(link.output_id);
-				float spacei = node->bounds.h / static_cast<float>(ni->output_count + 1);
-				float spaceo = node->bounds.h / static_cast<float>(no->input_count + 1);
-				auto l0 = layout_space.to_screen(
-					{ni->bounds.x + ni->bounds.w, 3.0f + ni->bounds.y + spacei * static_cast<float>(link.input_slot + 1)});
-				auto l1 = layout_space.to_screen(
-					{no->bounds.x, 3.0f + no->bounds.y + spaceo * static_cast<float>(link.output_slot + 1)});
-
-				l0.x -= editor.scrolling.x;
-				l0.y -= editor.scrolling.y;
-				l1.x -= editor.scrolling.x;
-				l1.y -= editor.scrolling.y;
-				canvas.stroke_curve(l0.x, l0.y, l0.x + 50.0f, l0.y, l1.x - 50.0f, l1.y, l1.x, l1.y, 1.0f, nk::color(100, 100, 100));
+			/* draw each link whose curve can intersect the viewport */
+			const auto& visible_links = editor.graph.visible_links(viewport);
+			for (link_handle h : visible_links) {
+				const node_link& link = editor.graph.links()[static_cast<std::size_t>(h)];
+				nk::vec2<float> l0;
+				nk::vec2<float> l1;
+				link_ends(editor.graph.get(link.input_node), link.input_slot, editor.graph.get(link.output_node), link.output_slot, l0, l1);
+				draw_curve(canvas, to_screen(l0), to_screen(l1));
 			}
+			editor.visible_links = static_cast<int>(visible_links.size());
 
-			if (updated != editor.nodes.end()) {
-				/* reshuffle nodes to have least recently selected node on top */
-				editor.nodes.splice(editor.nodes.end(), editor.nodes, updated);
-			}
-
-			/* node selection */
-			if (ctx.input_mouse_clicked(nk::buttons::left, layout_space.bounds())) {
-				editor.selected = nullptr;
-				editor.bounds = nk::rect<float>(ctx.get_input().mouse.pos.x, ctx.get_input().mouse.pos.y, 100, 200);
-				for (auto it = editor.nodes.begin(); it != editor.nodes.end(); ++it) {
-					struct nk_rect b = layout_space.rect_to_screen(it->bounds);
-					b.x -= editor.scrolling.x;
-					b.y -= editor.scrolling.y;
-					if (ctx.input_is_mouse_hovering_rect(b))
-						editor.selected = &*it;
-				}
-			}
+			/* statistics */
+			char stats[128];
+			const int stats_len = snprintf(stats, sizeof(stats), "nodes: %d/%d links: %d/%d build: %.2f ms",
+				editor.visible_nodes, static_cast<int>(editor.graph.nodes().size()),
+				editor.visible_links, static_cast<int>(editor.graph.links().size()), editor.build_time_ms);
+			canvas.draw_text({size.x + 4, size.y + 4, size.w - 8, 20}, stats, stats_len,
+				*ctx.get_style().font, nk::color(0, 0, 0, 0), nk::color(200, 200, 200));
 
 			/* contextual menu */
-			if (auto contextual = win.contextual_scoped({100, 220}, win.get_bounds(), nk::panel_flags::none)) {
+			if (auto contextual = win.contextual_scoped({120, 220}, win.get_bounds(), nk::panel_flags::none)) {
 				const char* grid_option[] = {"Show Grid", "Hide Grid"};
 				win.layout_row_dynamic(25, 1);
 				if (contextual.item_label("New", nk::text_alignment_flags::middle_center))
-					editor.add("New", {400, 260, 180, 220}, nk::color(255, 255, 255), 1, 2);
+					editor.graph.add("New", {400 + editor.scrolling.x, 260 + editor.scrolling.y, 180, 220}, nk::color(255, 255, 255), 1, 2);
 				if (contextual.item_label(grid_option[editor.show_grid], nk::text_alignment_flags::middle_center))
 					editor.show_grid = !editor.show_grid;
+				if (contextual.item_label("Stress test", nk::text_alignment_flags::middle_center)) {
+					editor.graph.stress_test(10000, 3);
+					editor.selected = -1;
+					editor.linking = node_linking{};
+				}
 			}
 		}
 
 		/* window content scrolling */
 		if (ctx.input_is_mouse_hovering_rect(win.get_bounds()) &&
 			ctx.input_is_mouse_down(nk::buttons::middle)) {
-			editor.scrolling.x += ctx.get_input().mouse.delta.x;
-			editor.scrolling.y += ctx.get_input().mouse.delta.y;
+			editor.scrolling.x += mouse.delta.x;
+			editor.scrolling.y += mouse.delta.y;
+			scrolled = true;
 		}
 	}
 
+	/* refresh build time only when the view changes - text that changes in every frame
+	 * would keep the main loop building frames even when the application is idle */
+	if (scrolled || editor.visible_nodes != last_visible_nodes || editor.visible_links != last_visible_links)
+		editor.build_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame_start).count();
+
 	return !ctx.window_is_closed("NodeEdit");
 }
@@ -0,0 +1,376 @@
+#pragma once
+
+// Data of the node editor demo, separate from its UI so that it can be benchmarked on its own
+// (see tests/benchmark/node_graph.cpp). Meant to scale to large graphs (10 000+ nodes):
+// - nodes and links live in contiguous storage and are referred to by index (they are never removed)
+// - uniform grids index node and link bounds so that hit-testing and culling do not iterate everything
+// - links are reindexed only when a node they are attached to moves to different grid cells
+
+#include <nukleus.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <math.h>
+
+// index into node_graph::nodes, stable because nodes are only appended
+using node_handle = int;
+// index into node_graph::links, stable because links are only appended
+using link_handle = int;
+
+struct node {
+	std::string id; // unique group name
+	std::string name;
+	nk::rect<float> bounds; // in editor space (not scrolled)
+	float value;
+	nk::color color;
+	int input_count;
+	int output_count;
+};
+
+struct node_link {
+	node_handle input_node;
+	int input_slot;
+	node_handle output_node;
+	int output_slot;
+};
+
+constexpr float connector_size = 8.0f;
+constexpr float curve_tangent = 50.0f;
+
+inline nk::vec2<float> output_connector(const node& nd, int slot)
+{
+	const float space = nd.bounds.h / static_cast<float>(nd.output_count + 1);
+	return {nd.bounds.x + nd.bounds.w, nd.bounds.y + space * static_cast<float>(slot + 1)};
+}
+
+inline nk::vec2<float> input_connector(const node& nd, int slot)
+{
+	const float space = nd.bounds.h / static_cast<float>(nd.input_count + 1);
+	return {nd.bounds.x, nd.bounds.y + space * static_cast<float>(slot + 1)};
+}
+
+inline nk::rect<float> connector_rect(nk::vec2<float> center)
+{
+	return {center.x - connector_size * 0.5f, center.y, connector_size, connector_size};
+}
+
+// area covered by the node including its connectors
+inline nk::rect<float> hit_bounds(const node& nd)
+{
+	return {nd.bounds.x - connector_size, nd.bounds.y, nd.bounds.w + 2.0f * connector_size, nd.bounds.h + connector_size};
+}
+
+// ends of the link's curve, in editor space
+inline void link_ends(const node& from, int from_slot, const node& to, int to_slot, nk::vec2<float>& l0, nk::vec2<float>& l1)
+{
+	const float offset = connector_size * 0.5f;
+	l0 = output_connector(from, from_slot);
+	l1 = input_connector(to, to_slot);
+	l0.y += offset;
+	l1.y += offset;
+}
+
+// bezier curve is contained within the bounding box of its control points
+inline nk::rect<float> curve_bounds(nk::vec2<float> l0, nk::vec2<float> l1)
+{
+	const float x0 = (std::min)(l0.x, l1.x - curve_tangent);
+	const float x1 = (std::max)(l0.x + curve_tangent, l1.x);
+	const float y0 = (std::min)(l0.y, l1.y);
+	const float y1 = (std::max)(l0.y, l1.y);
+	return {x0, y0, x1 - x0 + 1.0f, y1 - y0 + 1.0f};
+}
+
+inline bool contains(nk::rect<float> r, nk::vec2<float> p)
+{
+	return r.x <= p.x && p.x < r.x + r.w && r.y <= p.y && p.y < r.y + r.h;
+}
+
+inline bool intersects(nk::rect<float> a, nk::rect<float> b)
+{
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+// Uniform grid over editor space. Each item is registered in every cell its bounds overlap.
+// Queries may report the same item multiple times (once per overlapped cell).
+class spatial_grid
+{
+public:
+	void insert(int item, nk::rect<float> bounds)
+	{
+		for_each_cell(bounds, [&](std::uint64_t key) {
+			m_cells[key].push_back(item);
+		});
+	}
+
+	void erase(int item, nk::rect<float> bounds)
+	{
+		for_each_cell(bounds, [&](std::uint64_t key) {
+			auto it = m_cells.find(key);
+			if (it == m_cells.end())
+				return;
+
+			std::vector<int>& cell = it->second;
+			auto pos = std::find(cell.begin(), cell.end(), item);
+			if (pos != cell.end()) {
+				*pos = cell.back();
+				cell.pop_back();
+			}
+		});
+	}
+
+	// returns whether the item had to be moved to different cells
+	bool move(int item, nk::rect<float> old_bounds, nk::rect<float> new_bounds)
+	{
+		// most moves stay within the same cells
+		if (cell_range(old_bounds) == cell_range(new_bounds))
+			return false;
+
+		erase(item, old_bounds);
+		insert(item, new_bounds);
+		return true;
+	}
+
+	template <typename F>
+	void query(nk::rect<float> area, F&& f) const
+	{
+		for_each_cell(area, [&](std::uint64_t key) {
+			auto it = m_cells.find(key);
+			if (it == m_cells.end())
+				return;
+
+			for (int item : it->second)
+				f(item);
+		});
+	}
+
+	void clear()
+	{
+		m_cells.clear();
+	}
+
+private:
+	static constexpr float cell_size = 256.0f;
+
+	static int cell_index(float coord)
+	{
+		return static_cast<int>(floorf(coord / cell_size));
+	}
+
+	struct range {
+		int x0, y0, x1, y1;
+
+		bool operator==(range other) const
+		{
+			return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+		}
+	};
+
+	static range cell_range(nk::rect<float> area)
+	{
+		return {cell_index(area.x), cell_index(area.y), cell_index(area.x + area.w), cell_index(area.y + area.h)};
+	}
+
+	template <typename F>
+	static void for_each_cell(nk::rect<float> area, F&& f)
+	{
+		const range r = cell_range(area);
+		for (int y = r.y0; y <= r.y1; ++y)
+			for (int x = r.x0; x <= r.x1; ++x)
+				f((static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y));
+	}
+
+	std::unordered_map<std::uint64_t, std::vector<int>> m_cells;
+};
+
+class node_graph
+{
+public:
+	node_handle add(const char* name, nk::rect<float> bounds, nk::color col, int in_count, int out_count)
+	{
+		const auto h = static_cast<node_handle>(m_nodes.size());
+		node nd;
+		nd.id = "node#" + std::to_string(h);
+		nd.name = name;
+		nd.bounds = bounds;
+		nd.value = 0;
+		nd.color = col;
+		nd.input_count = in_count;
+		nd.output_count = out_count;
+		m_node_grid.insert(h, hit_bounds(nd));
+		m_nodes.push_back(std::move(nd));
+		m_ranks.push_back(++m_top_rank);
+		m_node_stamps.push_back(0);
+		m_node_links.emplace_back();
+		return h;
+	}
+
+	link_handle link(node_handle in_node, int in_slot, node_handle out_node, int out_slot)
+	{
+		const auto h = static_cast<link_handle>(m_links.size());
+		m_links.push_back(node_link{in_node, in_slot, out_node, out_slot});
+		m_link_bounds.push_back(compute_link_bounds(m_links.back()));
+		m_link_stamps.push_back(0);
+		m_link_grid.insert(h, m_link_bounds.back());
+		m_node_links[index(in_node)].push_back(h);
+		if (out_node != in_node)
+			m_node_links[index(out_node)].push_back(h);
+		return h;
+	}
+
+	void move(node_handle h, nk::rect<float> bounds)
+	{
+		node& nd = get(h);
+		const nk::rect<float> old_bounds = hit_bounds(nd);
+		nd.bounds = bounds;
+		m_node_grid.move(h, old_bounds, hit_bounds(nd));
+
+		for (link_handle l : m_node_links[index(h)]) {
+			nk::rect<float>& link_bounds = m_link_bounds[index(l)];
+			const nk::rect<float> new_bounds = compute_link_bounds(m_links[index(l)]);
+			m_link_grid.move(l, link_bounds, new_bounds);
+			link_bounds = new_bounds;
+		}
+	}
+
+	void bring_to_front(node_handle h)
+	{
+		m_ranks[index(h)] = ++m_top_rank;
+	}
+
+	// topmost node under the point, -1 if none
+	node_handle pick(nk::vec2<float> point)
+	{
+		node_handle result = -1;
+		query_nodes({point.x, point.y, 1, 1}, [&](node_handle h) {
+			if (contains(hit_bounds(get(h)), point) && (result < 0 || m_ranks[index(h)] > m_ranks[index(result)]))
+				result = h;
+		});
+		return result;
+	}
+
+	// nodes intersecting the area, in draw order (topmost last)
+	const std::vector<node_handle>& visible_nodes(nk::rect<float> area)
+	{
+		m_visible_nodes.clear();
+		query_nodes(area, [&](node_handle h) { m_visible_nodes.push_back(h); });
+		std::sort(m_visible_nodes.begin(), m_visible_nodes.end(), [&](node_handle lhs, node_handle rhs) {
+			return m_ranks[index(lhs)] < m_ranks[index(rhs)];
+		});
+		return m_visible_nodes;
+	}
+
+	// links whose curves can intersect the area, in no particular order
+	const std::vector<link_handle>& visible_links(nk::rect<float> area)
+	{
+		m_visible_links.clear();
+		const unsigned stamp = ++m_link_stamp;
+		m_link_grid.query(area, [&](link_handle h) {
+			unsigned& s = m_link_stamps[index(h)];
+			if (s == stamp)
+				return;
+
+			s = stamp;
+			if (intersects(m_link_bounds[index(h)], area))
+				m_visible_links.push_back(h);
+		});
+		return m_visible_links;
+	}
+
+	void clear()
+	{
+		m_nodes.clear();
+		m_links.clear();
+		m_link_bounds.clear();
+		m_node_links.clear();
+		m_ranks.clear();
+		m_node_stamps.clear();
+		m_link_stamps.clear();
+		m_node_grid.clear();
+		m_link_grid.clear();
+	}
+
+	// replaces the graph with a grid of node_count nodes, each linked to a few nodes nearby
+	void stress_test(int node_count, int links_per_node)
+	{
+		clear();
+		m_nodes.reserve(static_cast<std::size_t>(node_count));
+		m_links.reserve(static_cast<std::size_t>(node_count * links_per_node));
+
+		const int columns = static_cast<int>(sqrtf(static_cast<float>(node_count)));
+		for (int i = 0; i < node_count; ++i) {
+			const float x = static_cast<float>(i % columns) * 260.0f;
+			const float y = static_cast<float>(i / columns) * 260.0f;
+			const auto shade = static_cast<nk_byte>(i * 37);
+			add("Node", {x, y, 180, 220}, nk::color(shade, static_cast<nk_byte>(255 - shade), 128), 2, 2);
+		}
+
+		// mostly local links, like in a real graph
+		std::mt19937 gen(42);
+		std::uniform_int_distribution<int> offset(-2 * columns - 2, 2 * columns + 2);
+		std::uniform_int_distribution<int> slot(0, 1);
+		for (int i = 0; i < node_count; ++i) {
+			for (int n = 0; n < links_per_node; ++n) {
+				int target = i + offset(gen);
+				if (target < 0 || target >= node_count || target == i)
+					target = (i + 1) % node_count;
+
+				link(i, slot(gen), target, slot(gen));
+			}
+		}
+	}
+
+	node& get(node_handle h) { return m_nodes[index(h)]; }
+	const node& get(node_handle h) const { return m_nodes[index(h)]; }
+	const std::vector<node>& nodes() const { return m_nodes; }
+	const std::vector<node_link>& links() const { return m_links; }
+
+private:
+	static std::size_t index(int h)
+	{
+		NUKLEUS_ASSERT(h >= 0);
+		return static_cast<std::size_t>(h);
+	}
+
+	nk::rect<float> compute_link_bounds(const node_link& l) const
+	{
+		nk::vec2<float> l0;
+		nk::vec2<float> l1;
+		link_ends(get(l.input_node), l.input_slot, get(l.output_node), l.output_slot, l0, l1);
+		return curve_bounds(l0, l1);
+	}
+
+	// visits each node intersecting the area once
+	template <typename F>
+	void query_nodes(nk::rect<float> area, F&& f)
+	{
+		const unsigned stamp = ++m_node_stamp;
+		m_node_grid.query(area, [&](node_handle h) {
+			unsigned& s = m_node_stamps[index(h)];
+			if (s == stamp)
+				return;
+
+			s = stamp;
+			if (intersects(hit_bounds(get(h)), area))
+				f(h);
+		});
+	}
+
+	std::vector<node> m_nodes;
+	std::vector<node_link> m_links;
+	std::vector<nk::rect<float>> m_link_bounds; // as registered in m_link_grid
+	std::vector<std::vector<link_handle>> m_node_links; // links attached to each node
+	std::vector<std::uint64_t> m_ranks; // draw order, higher is on top
+	std::vector<unsigned> m_node_stamps; // query deduplication
+	std::vector<unsigned> m_link_stamps;
+	std::vector<node_handle> m_visible_nodes;
+	std::vector<link_handle> m_visible_links;
+	spatial_grid m_node_grid;
+	spatial_grid m_link_grid;
+	std::uint64_t m_top_rank = 0;
+	unsigned m_node_stamp = 0;
+	unsigned m_link_stamp = 0;
+};
@@ -23,6 +23,115 @@ static const char* symbols[NK_SYMBOL_MAX] =
 	"TRIANGLE_RIGHT_OUTLINE"
 };
 
+// Fields which nk_style_from_table derives from the color table. A change of a global color
+// is applied only to these (and only where it makes a difference), keeping edits made in other sections.
+constexpr auto button_colors = nk::make_style_fields<nk_style_button>(
+	&nk_style_button::normal, &nk_style_button::hover, &nk_style_button::active,
+	&nk_style_button::border_color, &nk_style_button::text_background,
+	&nk_style_button::text_normal, &nk_style_button::text_hover, &nk_style_button::text_active);
+
+constexpr auto toggle_colors = nk::make_style_fields<nk_style_toggle>(
+	&nk_style_toggle::normal, &nk_style_toggle::hover, &nk_style_toggle::active,
+	&nk_style_toggle::cursor_normal, &nk_style_toggle::cursor_hover,
+	&nk_style_toggle::border_color, &nk_style_toggle::text_background,
+	&nk_style_toggle::text_normal, &nk_style_toggle::text_hover, &nk_style_toggle::text_active);
+
+constexpr auto selectable_colors = nk::make_style_fields<nk_style_selectable>(
+	&nk_style_selectable::normal, &nk_style_selectable::hover, &nk_style_selectable::pressed,
+	&nk_style_selectable::normal_active, &nk_style_selectable::hover_active, &nk_style_selectable::pressed_active,
+	&nk_style_selectable::text_normal, &nk_style_selectable::text_hover, &nk_style_selectable::text_pressed,
+	&nk_style_selectable::text_normal_active, &nk_style_selectable::text_hover_active,
+	&nk_style_selectable::text_pressed_active, &nk_style_selectable::text_background);
+
+constexpr auto slider_colors = nk::make_style_fields<nk_style_slider>(
+	&nk_style_slider::normal, &nk_style_slider::hover, &nk_style_slider::active,
+	&nk_style_slider::bar_normal, &nk_style_slider::bar_hover, &nk_style_slider::bar_active, &nk_style_slider::bar_filled,
+	&nk_style_slider::cursor_normal, &nk_style_slider::cursor_hover, &nk_style_slider::cursor_active,
+	nk::style_subfields_of(&nk_style_slider::inc_button, button_colors),
+	nk::style_subfields_of(&nk_style_slider::dec_button, button_colors));
+
+constexpr auto knob_colors = nk::make_style_fields<nk_style_knob>(
+	&nk_style_knob::normal, &nk_style_knob::hover, &nk_style_knob::active, &nk_style_knob::border_color,
+	&nk_style_knob::knob_normal, &nk_style_knob::knob_hover, &nk_style_knob::knob_active, &nk_style_knob::knob_border_color,
+	&nk_style_knob::cursor_normal, &nk_style_knob::cursor_hover, &nk_style_knob::cursor_active);
+
+constexpr auto progress_colors = nk::make_style_fields<nk_style_progress>(
+	&nk_style_progress::normal, &nk_style_progress::hover, &nk_style_progress::active,
+	&nk_style_progress::cursor_normal, &nk_style_progress::cursor_hover, &nk_style_progress::cursor_active,
+	&nk_style_progress::border_color, &nk_style_progress::cursor_border_color);
+
+constexpr auto scrollbar_colors = nk::make_style_fields<nk_style_scrollbar>(
+	&nk_style_scrollbar::normal, &nk_style_scrollbar::hover, &nk_style_scrollbar::active,
+	&nk_style_scrollbar::cursor_normal, &nk_style_scrollbar::cursor_hover, &nk_style_scrollbar::cursor_active,
+	&nk_style_scrollbar::border_color, &nk_style_scrollbar::cursor_border_color,
+	nk::style_subfields_of(&nk_style_scrollbar::inc_button, button_colors),
+	nk::style_subfields_of(&nk_style_scrollbar::dec_button, button_colors));
+
+constexpr auto edit_colors = nk::make_style_fields<nk_style_edit>(
+	&nk_style_edit::normal, &nk_style_edit::hover, &nk_style_edit::active,
+	&nk_style_edit::cursor_normal, &nk_style_edit::cursor_hover,
+	&nk_style_edit::cursor_text_normal, &nk_style_edit::cursor_text_hover, &nk_style_edit::border_color,
+	&nk_style_edit::text_normal, &nk_style_edit::text_hover, &nk_style_edit::text_active,
+	&nk_style_edit::selected_normal, &nk_style_edit::selected_hover,
+	&nk_style_edit::selected_text_normal, &nk_style_edit::selected_text_hover,
+	nk::style_subfields_of(&nk_style_edit::scrollbar, scrollbar_colors));
+
+constexpr auto property_colors = nk::make_style_fields<nk_style_property>(
+	&nk_style_property::normal, &nk_style_property::hover, &nk_style_property::active, &nk_style_property::border_color,
+	&nk_style_property::label_normal, &nk_style_property::label_hover, &nk_style_property::label_active,
+	nk::style_subfields_of(&nk_style_property::edit, edit_colors),
+	nk::style_subfields_of(&nk_style_property::inc_button, button_colors),
+	nk::style_subfields_of(&nk_style_property::dec_button, button_colors));
+
+constexpr auto chart_colors = nk::make_style_fields<nk_style_chart>(
+	&nk_style_chart::background, &nk_style_chart::border_color, &nk_style_chart::selected_color, &nk_style_chart::color);
+
+constexpr auto combo_colors = nk::make_style_fields<nk_style_combo>(
+	&nk_style_combo::normal, &nk_style_combo::hover, &nk_style_combo::active, &nk_style_combo::border_color,
+	&nk_style_combo::label_normal, &nk_style_combo::label_hover, &nk_style_combo::label_active,
+	&nk_style_combo::symbol_normal, &nk_style_combo::symbol_hover, &nk_style_combo::symbol_active,
+	nk::style_subfields_of(&nk_style_combo::button, button_colors));
+
+constexpr auto tab_colors = nk::make_style_fields<nk_style_tab>(
+	&nk_style_tab::background, &nk_style_tab::border_color, &nk_style_tab::text,
+	nk::style_subfields_of(&nk_style_tab::tab_minimize_button, button_colors),
+	nk::style_subfields_of(&nk_style_tab::tab_maximize_button, button_colors),
+	nk::style_subfields_of(&nk_style_tab::node_minimize_button, button_colors),
+	nk::style_subfields_of(&nk_style_tab::node_maximize_button, button_colors));
+
+constexpr auto window_header_colors = nk::make_style_fields<nk_style_window_header>(
+	&nk_style_window_header::normal, &nk_style_window_header::hover, &nk_style_window_header::active,
+	&nk_style_window_header::label_normal, &nk_style_window_header::label_hover, &nk_style_window_header::label_active,
+	nk::style_subfields_of(&nk_style_window_header::close_button, button_colors),
+	nk::style_subfields_of(&nk_style_window_header::minimize_button, button_colors));
+
+constexpr auto window_colors = nk::make_style_fields<nk_style_window>(
+	nk::style_subfields_of(&nk_style_window::header, window_header_colors),
+	&nk_style_window::background, &nk_style_window::fixed_background, &nk_style_window::border_color,
+	&nk_style_window::popup_border_color, &nk_style_window::combo_border_color,
+	&nk_style_window::contextual_border_color, &nk_style_window::menu_border_color,
+	&nk_style_window::group_border_color, &nk_style_window::tooltip_border_color, &nk_style_window::scaler);
+
+constexpr auto color_fields = nk::make_style_fields<nk_style>(
+	nk::style_subfields_of(&nk_style::text, nk::make_style_fields<nk_style_text>(&nk_style_text::color)),
+	nk::style_subfields_of(&nk_style::button, button_colors),
+	nk::style_subfields_of(&nk_style::contextual_button, button_colors),
+	nk::style_subfields_of(&nk_style::menu_button, button_colors),
+	nk::style_subfields_of(&nk_style::option, toggle_colors),
+	nk::style_subfields_of(&nk_style::checkbox, toggle_colors),
+	nk::style_subfields_of(&nk_style::selectable, selectable_colors),
+	nk::style_subfields_of(&nk_style::slider, slider_colors),
+	nk::style_subfields_of(&nk_style::knob, knob_colors),
+	nk::style_subfields_of(&nk_style::progress, progress_colors),
+	nk::style_subfields_of(&nk_style::property, property_colors),
+	nk::style_subfields_of(&nk_style::edit, edit_colors),
+	nk::style_subfields_of(&nk_style::chart, chart_colors),
+	nk::style_subfields_of(&nk_style::scrollh, scrollbar_colors),
+	nk::style_subfields_of(&nk_style::scrollv, scrollbar_colors),
+	nk::style_subfields_of(&nk_style::tab, tab_colors),
+	nk::style_subfields_of(&nk_style::combo, combo_colors),
+	nk::style_subfields_of(&nk_style::window, window_colors));
+
 bool style_rgb(nk::window& win, const char* name, nk_color& color)
 {
 	win.label(name, nk::text_alignment_flags::middle_left);
@@ -99,6 +208,7 @@ void style_global_colors(nk::context& ctx, nk::window& win, nk::color_table& col
 	};
 
 	int clicked = 0;
+	const nk::color_table previous_table = color_table;
 
 	win.layout_row_dynamic(30, 2);
 	for (int i = 0; i < NK_COLOR_COUNT; ++i) {
@@ -106,7 +216,7 @@ void style_global_colors(nk::context& ctx, nk::window& win, nk::color_table& col
 	}
 
 	if (clicked) {
-		ctx.style_from_table(color_table);
+		ctx.style_apply_changes(ctx.style_compile(previous_table), ctx.style_compile(color_table), color_fields);
 	}
 }
 
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <iostream>
+#include <cstdio>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_opengl.h>
@@ -134,9 +135,31 @@ void nk_sdl_device_upload_atlas(GLuint& font_tex, const void* image, GLsizei wid
 	glBindTexture(GL_TEXTURE_2D, font_tex);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+	/* the atlas is baked as alpha8 - rows are tightly packed, not aligned to 4 bytes */
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	/* GL_ALPHA + default GL_MODULATE texture environment: vertex color with alpha multiplied by coverage */
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, image);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 }
 
+#ifdef NUKLEUS_TRACING
+void nk_sdl_export_trace(const char* path)
+{
+	std::FILE* file = std::fopen(path, "wb");
+	if (file == nullptr) {
+		std::cerr << "failed to open " << path << "\n";
+		return;
+	}
+
+	nk::trace_export_json(file, [](void* userdata, const char* data, int len) {
+		std::fwrite(data, 1, static_cast<std::size_t>(len), static_cast<std::FILE*>(userdata));
+	});
+	std::fclose(file);
+	nk::trace_clear();
+	std::cout << "trace saved to " << path << "\n";
+}
+#endif
+
 struct nk_sdl_vertex
 {
 	float position[2];
@@ -151,13 +174,9 @@ struct buffers
 	nk::buffer ebuf = nk::buffer::init_default();
 };
 
-void nk_sdl_render(nk::context& ctx, buffers& buffs, nk_draw_null_texture tex_null, SDL_Window& win, nk_anti_aliasing aa, Uint64& time_of_last_frame)
+void nk_sdl_render(nk::context& ctx, buffers& buffs, nk_draw_null_texture tex_null, SDL_Window& win, nk_anti_aliasing aa, nk::convert_stats* stats = nullptr)
 {
 	/* setup global state */
-	const Uint64 now = SDL_GetTicks64();
-	ctx.get_delta_time_seconds() = static_cast<float>(now - time_of_last_frame) / 1000;
-	time_of_last_frame = now;
-
 	int width{}, height{};
 	SDL_GetWindowSize(&win, &width, &height);
 	int display_width{}, display_height{};
@@ -212,7 +231,15 @@ void nk_sdl_render(nk::context& ctx, buffers& buffs, nk_draw_null_texture tex_nu
 		config.global_alpha = 1.0f;
 		config.shape_AA = aa;
 		config.line_AA = aa;
-		const nk::convert_result_flags result = ctx.convert(buffs.cmds, buffs.vbuf, buffs.ebuf, config);
+		/* statistics are collected only when asked for, plain conversion does no extra work */
+		nk::convert_result_flags result;
+		if (stats) {
+			*stats = ctx.convert_with_stats(buffs.cmds, buffs.vbuf, buffs.ebuf, config);
+			result = stats->result;
+		}
+		else {
+			result = ctx.convert(buffs.cmds, buffs.vbuf, buffs.ebuf, config);
+		}
 		if (result != nk::convert_result_flags::success)
 			std::cerr << "error when converting: " << static_cast<int>(result) << "\n";
 
@@ -229,23 +256,29 @@ void nk_sdl_render(nk::context& ctx, buffers& buffs, nk_draw_null_texture tex_nu
 		}
 
 		/* iterate over and execute each draw command */
-		auto offset = static_cast<const nk_draw_index*>(buffs.ebuf.memory());
-		for (const nk_draw_command& cmd : ctx.draw_commands(buffs.cmds))
 		{
-			if (!cmd.elem_count)
-				continue;
-
-			glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(cmd.texture.id));
-			glScissor(
-				static_cast<GLint>(cmd.clip_rect.x * scale.x),
-				static_cast<GLint>((height - static_cast<GLint>(cmd.clip_rect.y + cmd.clip_rect.h)) * scale.y),
-				static_cast<GLint>(cmd.clip_rect.w * scale.x),
-				static_cast<GLint>(cmd.clip_rect.h * scale.y));
-			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(cmd.elem_count), GL_UNSIGNED_SHORT, offset);
-
-			offset += cmd.elem_count;
+			NUKLEUS_TRACE_SCOPE("render", "draw_commands");
+			auto offset = static_cast<const nk_draw_index*>(buffs.ebuf.memory());
+			for (const nk_draw_command& cmd : ctx.draw_commands(buffs.cmds))
+			{
+				if (!cmd.elem_count)
+					continue;
+
+				glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(cmd.texture.id));
+				glScissor(
+					static_cast<GLint>(cmd.clip_rect.x * scale.x),
+					static_cast<GLint>((height - static_cast<GLint>(cmd.clip_rect.y + cmd.clip_rect.h)) * scale.y),
+					static_cast<GLint>(cmd.clip_rect.w * scale.x),
+					static_cast<GLint>(cmd.clip_rect.h * scale.y));
+				glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(cmd.elem_count), GL_UNSIGNED_SHORT, offset);
+
+				offset += cmd.elem_count;
+			}
 		}
 
+		if (nk::latency_tracker* latency = ctx.get_latency_tracker())
+			latency->mark(nk::latency_stage::submit);
+
 		ctx.clear();
 		buffs.cmds.clear();
 		buffs.vbuf.clear();
@@ -271,6 +304,36 @@ void nk_sdl_render(nk::context& ctx, buffers& buffs, nk_draw_null_texture tex_nu
 	glPopAttrib();
 }
 
+/* high resolution clock, in the same epoch as SDL_GetTicks64 (and event timestamps) */
+double nk_sdl_seconds()
+{
+	static const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	static const Uint64 counter_start = SDL_GetPerformanceCounter();
+	static const double ticks_start = static_cast<double>(SDL_GetTicks64()) / 1000;
+	return ticks_start + static_cast<double>(SDL_GetPerformanceCounter() - counter_start) / frequency;
+}
+
+/* SDL2 event timestamps are 32-bit milliseconds that wrap after ~49 days, extend them to the 64-bit clock */
+double nk_sdl_event_seconds(const SDL_Event& evt)
+{
+	const Uint64 now = SDL_GetTicks64();
+	const Uint32 age = static_cast<Uint32>(now) - evt.common.timestamp;
+	return static_cast<double>(now - age) / 1000;
+}
+
+/* wait for an event no longer than timeout (in seconds), negative timeout waits indefinitely */
+bool nk_sdl_wait_event(SDL_Event& evt, double timeout)
+{
+	if (timeout < 0)
+		return SDL_WaitEvent(&evt) != 0;
+
+	if (timeout <= 0)
+		return SDL_PollEvent(&evt) != 0;
+
+	/* round up, waking before the deadline would only cause another wait */
+	return SDL_WaitEventTimeout(&evt, static_cast<int>(timeout * 1000) + 1) != 0;
+}
+
 void nk_sdl_clipboard_paste(nk_handle /*usr*/, nk_text_edit* edit)
 {
 	char* text = SDL_GetClipboardText();
@@ -350,7 +413,7 @@ int main()
 		atlas.begin();
 		// add fonts here... if none are loaded a default font will be used
 		nk::vec2<int> dimentions{};
-		const void* image = atlas.bake_rgba32(dimentions);
+		const void* image = atlas.bake_alpha8(dimentions);
 		nk_sdl_device_upload_atlas(font_tex, image, dimentions.x, dimentions.y);
 		tex_null = atlas.end(nk_handle_id(static_cast<int>(font_tex)));
 	}
@@ -366,28 +429,71 @@ int main()
 
 	buffers buffs;
 	Uint64 time_of_last_frame = SDL_GetTicks64();
+	/* do not render when nothing changes - wait for input or for a frame requested by the UI */
+	nk::frame_scheduler scheduler;
+	/* measure time from SDL events to the swap of the frame that processed them */
+	nk::latency_tracker latency(&nk_sdl_seconds);
+	ctx.set_latency_tracker(&latency);
+	/* measure cost of each window; vertices can be counted because commands are rendered through ctx.convert */
+	nk::window_profiler::entry profiler_storage[nk::window_profiler::storage_size(16)];
+	nk::window_profiler profiler(profiler_storage, &nk_sdl_seconds, true);
+	ctx.set_window_profiler(&profiler);
+	/* statistics of the last conversion */
+	nk::convert_stats draw_stats;
 
 	nk::colorf bg(0.10f, 0.18f, 0.24f);
 	// This is here because nk_default_color_style is only exposed under NK_IMPLEMENTATION.
 	// Otherwise it would be moved to inside of style_configurator().
 	nk::color_table color_table(nk_default_color_style);
 	nk::color_table default_color_table(nk_default_color_style);
+#ifdef NUKLEUS_TRACING
+	/* press F12 to save events recorded since the last save */
+	bool export_trace = false;
+#endif
 
 	while (true)
 	{
+#ifdef NUKLEUS_TRACING
+		if (export_trace) {
+			nk_sdl_export_trace("nukleus_trace.json");
+			export_trace = false;
+		}
+#endif
+
 		/* Input */
 		SDL_Event evt;
+		bool has_event = nk_sdl_wait_event(evt, scheduler.get_wait_timeout(nk_sdl_seconds()));
+		if (has_event)
+			scheduler.request_frame();
+
+		if (!scheduler.should_build_frame(nk_sdl_seconds()))
+			continue;
+
+		NUKLEUS_TRACE_SCOPE("demo", "frame");
 		{
 			auto input = ctx.input_scoped();
-			while (SDL_PollEvent(&evt)) {
+			for (; has_event; has_event = SDL_PollEvent(&evt) != 0) {
 				if (evt.type == SDL_QUIT)
 					return 0;
 
-				nk_sdl_handle_event(input, evt);
+				if (evt.type == SDL_WINDOWEVENT)
+					scheduler.request_present();
+
+#ifdef NUKLEUS_TRACING
+				if (evt.type == SDL_KEYUP && evt.key.keysym.sym == SDLK_F12)
+					export_trace = true;
+#endif
+
+				if (nk_sdl_handle_event(input, evt))
+					input.event_time(nk_sdl_event_seconds(evt));
 			}
 			nk_sdl_handle_grab(ctx.get_input(), *win); /* optional grabbing behavior */
 		}
 
+		const Uint64 now = SDL_GetTicks64();
+		ctx.get_delta_time_seconds() = static_cast<float>(now - time_of_last_frame) / 1000;
+		time_of_last_frame = now;
+
 		/* GUI */
 		// reordered windows from original example for better visibility
 		node_editor(ctx);
@@ -396,8 +502,17 @@ int main()
 		style_configurator(ctx, default_color_table, color_table);
 		demo_window(ctx, bg);
 		calculator(ctx);
+		latency_overlay(ctx, latency);
+		window_cost_overlay(ctx, profiler);
+		draw_stats_overlay(ctx, draw_stats);
 
 		/* Draw */
+		if (!scheduler.end_frame(ctx, nk_sdl_seconds())) {
+			ctx.clear(); /* the same as the last presented frame */
+			latency.discard_frame();
+			continue;
+		}
+
 		SDL_GetWindowSize(win.get(), &win_width, &win_height);
 		glViewport(0, 0, win_width, win_height);
 		glClear(GL_COLOR_BUFFER_BIT);
@@ -406,8 +521,9 @@ int main()
 		 * with blending, scissor, face culling, depth test and viewport and
 		 * defaults everything back into a default state.
 		 * Make sure to either a.) save and restore or b.) reset your own state after rendering the UI. */
-		nk_sdl_render(ctx, buffs, tex_null, *win, NK_ANTI_ALIASING_ON, time_of_last_frame);
+		nk_sdl_render(ctx, buffs, tex_null, *win, NK_ANTI_ALIASING_ON, &draw_stats);
 		SDL_GL_SwapWindow(win.get());
+		latency.mark(nk::latency_stage::present);
 	}
 
 	return 0;
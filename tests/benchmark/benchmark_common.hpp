@@ -0,0 +1,47 @@
+#pragma once
+
+#include <nukleus.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+// Minimal timing facility, benchmarks are plain executables which print their results.
+// Run them from release builds, results of unoptimized code are meaningless.
+
+namespace benchmark {
+
+template <typename T>
+struct sink_storage
+{
+	static volatile T value;
+};
+
+template <typename T>
+volatile T sink_storage<T>::value;
+
+// prevents the compiler from removing computations whose results are otherwise unused
+template <typename T>
+void sink(T value)
+{
+	sink_storage<T>::value = value;
+}
+
+// average time of one call of f(i) for i in [0, count), in nanoseconds
+template <typename Index, typename F>
+double measure(Index count, F f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	for (Index i = 0; i < count; ++i)
+		f(i);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	return ns / static_cast<double>(count);
+}
+
+template <typename Index, typename F>
+void run(const char* name, Index count, F f)
+{
+	std::printf("%-32s %10.1f ns/op\n", name, measure(count, f));
+}
+
+}
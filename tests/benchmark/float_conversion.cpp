@@ -0,0 +1,99 @@
+// Benchmark of Nukleus' string <=> double conversions against the standard library
+// (strtod and snprintf, in C++17 also std::from_chars and std::to_chars).
+// Ambiguous inputs (very close to a rounding boundary) are measured separately: they take the slow exact path.
+
+#define NK_IMPLEMENTATION
+#include "benchmark_common.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L
+	#include <charconv>
+#endif
+
+namespace {
+
+double from_bits(std::uint64_t bits)
+{
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+}
+
+int main()
+{
+	constexpr std::size_t count = 200000;
+	std::mt19937_64 rng(30);
+
+	std::vector<double> values;
+	values.reserve(count);
+	while (values.size() < count) {
+		// uniformly distributed bit patterns (all magnitudes) without infinities and NaNs
+		const double value = from_bits(rng() & 0x7FEFFFFFFFFFFFFFull);
+		values.push_back(value);
+	}
+
+	std::vector<std::string> shortest(count);
+	std::vector<std::string> typed(count);
+	std::vector<std::string> ambiguous(count / 100);
+	for (std::size_t i = 0; i < count; ++i) {
+		char buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%.17g", values[i]);
+		shortest[i] = buffer;
+		// short numbers, as typed by the user in property widgets
+		std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(rng() % 4u), static_cast<double>(rng() % 100000u) / 7.0);
+		typed[i] = buffer;
+	}
+
+	for (std::size_t i = 0; i < ambiguous.size(); ++i) {
+		// 9007199254740993 = 2^53 + 1 is exactly between 2 doubles, the digits make it just above or at the boundary
+		ambiguous[i] = "9007199254740993";
+		if (i % 2u)
+			ambiguous[i] += ".00000000000000000000000001";
+	}
+
+	benchmark::run("strtod (17 digits)", count, [&](std::size_t i) { benchmark::sink(std::strtod(shortest[i].c_str(), nullptr)); });
+	benchmark::run("nukleus parse (17 digits)", count, [&](std::size_t i) { benchmark::sink(nk::detail::fp::parse(shortest[i].c_str(), nullptr)); });
+	benchmark::run("strtod (typed)", count, [&](std::size_t i) { benchmark::sink(std::strtod(typed[i].c_str(), nullptr)); });
+	benchmark::run("nukleus parse (typed)", count, [&](std::size_t i) { benchmark::sink(nk::detail::fp::parse(typed[i].c_str(), nullptr)); });
+	benchmark::run("strtod (ambiguous)", ambiguous.size(), [&](std::size_t i) { benchmark::sink(std::strtod(ambiguous[i].c_str(), nullptr)); });
+	benchmark::run("nukleus parse (ambiguous)", ambiguous.size(), [&](std::size_t i) { benchmark::sink(nk::detail::fp::parse(ambiguous[i].c_str(), nullptr)); });
+#if __cplusplus >= 201703L
+	const auto from_chars = [](const std::string& text) {
+		double value = 0;
+		std::from_chars(text.data(), text.data() + text.size(), value);
+		return value;
+	};
+	benchmark::run("from_chars (17 digits)", count, [&](std::size_t i) { benchmark::sink(from_chars(shortest[i])); });
+	benchmark::run("from_chars (typed)", count, [&](std::size_t i) { benchmark::sink(from_chars(typed[i])); });
+	benchmark::run("from_chars (ambiguous)", ambiguous.size(), [&](std::size_t i) { benchmark::sink(from_chars(ambiguous[i])); });
+#endif
+
+	benchmark::run("snprintf %.17g", count, [&](std::size_t i) {
+		char buffer[NK_MAX_NUMBER_BUFFER + 16];
+		std::snprintf(buffer, sizeof(buffer), "%.17g", values[i]);
+		benchmark::sink(buffer[0]);
+	});
+#if __cplusplus >= 201703L
+	benchmark::run("to_chars (shortest)", count, [&](std::size_t i) {
+		char buffer[NK_MAX_NUMBER_BUFFER + 16];
+		std::to_chars(buffer, buffer + sizeof(buffer), values[i]);
+		benchmark::sink(buffer[0]);
+	});
+#endif
+	benchmark::run("nukleus write_fixed", count, [&](std::size_t i) {
+		char buffer[NK_MAX_NUMBER_BUFFER];
+		nk::detail::fp::write_fixed(buffer, NK_MAX_NUMBER_BUFFER, values[i]);
+		benchmark::sink(buffer[0]);
+	});
+
+	return 0;
+}
@@ -0,0 +1,91 @@
+// Benchmark of the node editor demo's graph (10 000 nodes, 30 000 links): viewport culling,
+// hit-testing and moving nodes with spatial grids against linear scans over all nodes and links.
+
+#include "benchmark_common.hpp"
+#include "common/node_graph.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+int linear_visible_nodes(const node_graph& graph, nk::rect<float> area)
+{
+	int result = 0;
+	for (const node& nd : graph.nodes())
+		if (intersects(hit_bounds(nd), area))
+			++result;
+	return result;
+}
+
+int linear_visible_links(const node_graph& graph, nk::rect<float> area)
+{
+	int result = 0;
+	for (const node_link& link : graph.links()) {
+		nk::vec2<float> l0;
+		nk::vec2<float> l1;
+		link_ends(graph.get(link.input_node), link.input_slot, graph.get(link.output_node), link.output_slot, l0, l1);
+		if (intersects(curve_bounds(l0, l1), area))
+			++result;
+	}
+	return result;
+}
+
+node_handle linear_pick(const node_graph& graph, nk::vec2<float> point)
+{
+	// ignores draw order, a lower bound of the cost of a linear pick
+	node_handle result = -1;
+	for (std::size_t i = 0; i < graph.nodes().size(); ++i)
+		if (contains(hit_bounds(graph.nodes()[i]), point))
+			result = static_cast<node_handle>(i);
+	return result;
+}
+
+}
+
+int main()
+{
+	node_graph graph;
+	benchmark::run("stress_test(10000, 3)", 1, [&](int) { graph.stress_test(10000, 3); });
+
+	// 800x600 viewports scattered over the graph (100 columns of 260 px)
+	constexpr int count = 1000;
+	std::mt19937 gen(39);
+	std::uniform_real_distribution<float> coord(-400.0f, 26000.0f);
+	std::vector<nk::rect<float>> viewports;
+	std::vector<nk::vec2<float>> points;
+	for (int i = 0; i < count; ++i) {
+		viewports.emplace_back(coord(gen), coord(gen), 800.0f, 600.0f);
+		points.emplace_back(coord(gen), coord(gen));
+	}
+
+	// sanity check: both methods find the same objects
+	for (const nk::rect<float>& viewport : viewports) {
+		if (static_cast<int>(graph.visible_nodes(viewport).size()) != linear_visible_nodes(graph, viewport)
+			|| static_cast<int>(graph.visible_links(viewport).size()) != linear_visible_links(graph, viewport)) {
+			std::printf("grid and linear results differ\n");
+			return 1;
+		}
+	}
+
+	const auto index = [](int i) { return static_cast<std::size_t>(i); };
+	benchmark::run("visible nodes (grid)", count, [&](int i) { benchmark::sink(static_cast<int>(graph.visible_nodes(viewports[index(i)]).size())); });
+	benchmark::run("visible nodes (linear)", count, [&](int i) { benchmark::sink(linear_visible_nodes(graph, viewports[index(i)])); });
+	benchmark::run("visible links (grid)", count, [&](int i) { benchmark::sink(static_cast<int>(graph.visible_links(viewports[index(i)]).size())); });
+	benchmark::run("visible links (linear)", count, [&](int i) { benchmark::sink(linear_visible_links(graph, viewports[index(i)])); });
+	benchmark::run("pick (grid)", count, [&](int i) { benchmark::sink(graph.pick(points[index(i)])); });
+	benchmark::run("pick (linear)", count, [&](int i) { benchmark::sink(linear_pick(graph, points[index(i)])); });
+
+	// dragging: nodes move by a few pixels per frame, links attached to them are reindexed
+	std::uniform_int_distribution<node_handle> any_node(0, static_cast<node_handle>(graph.nodes().size()) - 1);
+	benchmark::run("move node by 5 px", count * 10, [&](int) {
+		const node_handle h = any_node(gen);
+		nk::rect<float> bounds = graph.get(h).bounds;
+		bounds.x += 5.0f;
+		bounds.y += 5.0f;
+		graph.move(h, bounds);
+	});
+
+	return 0;
+}
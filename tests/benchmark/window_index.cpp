@@ -0,0 +1,82 @@
+// Benchmark of name-based window lookups (context::window_find) with and without window_index,
+// for window counts from 10 to 5000.
+
+#include "benchmark_common.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+float text_width(nk_handle, float, const char*, int len)
+{
+	return 8.0f * static_cast<float>(len);
+}
+
+// one frame in which all windows are declared (and created if they do not exist)
+void build_frame(nk::context& ctx, const std::vector<std::string>& names)
+{
+	{
+		auto input = ctx.input_scoped();
+	}
+
+	for (std::size_t i = 0; i < names.size(); ++i) {
+		const float offset = static_cast<float>(i % 100u) * 10.0f;
+		auto win = ctx.window_scoped(names[i].c_str(), {offset, offset, 200, 100}, nk::window_flags::border);
+	}
+
+	ctx.clear();
+}
+
+double lookup_ns(nk::context& ctx, const std::vector<std::string>& names, int rounds)
+{
+	const double round_ns = benchmark::measure(rounds, [&](int) {
+		for (const std::string& name : names)
+			benchmark::sink(ctx.window_find(name.c_str()));
+	});
+	return round_ns / static_cast<double>(names.size());
+}
+
+}
+
+int main()
+{
+	nk_user_font font = {};
+	font.height = 13.0f;
+	font.width = &text_width;
+
+	std::printf("%8s %16s %16s\n", "windows", "linear ns/find", "index ns/find");
+	const int window_counts[] = {10, 50, 100, 500, 1000, 2000, 5000};
+	for (const int count : window_counts) {
+		auto ctx = nk::context::init_default(font);
+
+		std::vector<std::string> names;
+		for (int i = 0; i < count; ++i)
+			names.push_back("panel " + std::to_string(i));
+
+		build_frame(ctx, names);
+		build_frame(ctx, names);
+
+		// about the same number of lookups for every window count
+		const int rounds = 1 + 200000 / count;
+		const double linear = lookup_ns(ctx, names, rounds);
+
+		std::vector<nk::window_index::entry> storage(static_cast<std::size_t>(nk::window_index::storage_size(count)));
+		nk::window_index index(nk::span<nk::window_index::entry>(storage.data(), static_cast<int>(storage.size())));
+		ctx.set_window_index(&index);
+		const double indexed = lookup_ns(ctx, names, rounds);
+
+		// steady state: frames do not create or free windows, the index is not rebuilt
+		build_frame(ctx, names);
+		if (ctx.window_find(names.back().c_str()) == nullptr) {
+			std::printf("window not found\n");
+			return 1;
+		}
+
+		ctx.set_window_index(nullptr);
+		std::printf("%8d %16.1f %16.1f\n", count, linear, indexed);
+	}
+
+	return 0;
+}
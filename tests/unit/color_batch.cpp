@@ -0,0 +1,238 @@
+// Differential tests of batch color conversions (span overloads) against the single-value conversions.
+
+#include "test_common.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// sizes around the block size of the kernels, the last block is padded
+const int sizes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 100, 1000};
+
+// both sides are compiled with -ffast-math, vectorized and scalar code may round differently
+bool close(float lhs, float rhs)
+{
+	return std::fabs(lhs - rhs) <= 1e-5f * (1.0f + std::fabs(lhs) + std::fabs(rhs));
+}
+
+// byte results are truncated from floats, a last-bit difference can move them by one
+bool close(nk::byte lhs, nk::byte rhs)
+{
+	return lhs < rhs ? rhs - lhs <= 1 : lhs - rhs <= 1;
+}
+
+bool equal(nk::color lhs, nk::color rhs)
+{
+	return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+bool close(nk::color lhs, nk::color rhs)
+{
+	return close(lhs.r, rhs.r) && close(lhs.g, rhs.g) && close(lhs.b, rhs.b) && close(lhs.a, rhs.a);
+}
+
+bool close(nk::color_hsva lhs, nk::color_hsva rhs)
+{
+	return close(lhs.h, rhs.h) && close(lhs.s, rhs.s) && close(lhs.v, rhs.v) && close(lhs.a, rhs.a);
+}
+
+bool close(nk::colorf lhs, nk::colorf rhs)
+{
+	return close(lhs.r, rhs.r) && close(lhs.g, rhs.g) && close(lhs.b, rhs.b) && close(lhs.a, rhs.a);
+}
+
+bool close(nk::colorf_hsva lhs, nk::colorf_hsva rhs)
+{
+	return close(lhs.h, rhs.h) && close(lhs.s, rhs.s) && close(lhs.v, rhs.v) && close(lhs.a, rhs.a);
+}
+
+bool equal(nk::colorf lhs, nk::colorf rhs)
+{
+	return !(lhs.r < rhs.r || rhs.r < lhs.r) && !(lhs.g < rhs.g || rhs.g < lhs.g)
+		&& !(lhs.b < rhs.b || rhs.b < lhs.b) && !(lhs.a < rhs.a || rhs.a < lhs.a);
+}
+
+nk::byte random_byte(test::random& rng)
+{
+	return static_cast<nk::byte>(rng.below(256));
+}
+
+// in range [min, max]
+float random_float(test::random& rng, float min, float max)
+{
+	return min + (max - min) * static_cast<float>(rng.below(1 << 20)) / static_cast<float>((1 << 20) - 1);
+}
+
+// every fourth color has equal channels (zero saturation), some others have 2 equal channels
+nk::color random_color(test::random& rng)
+{
+	nk::color col(random_byte(rng), random_byte(rng), random_byte(rng), random_byte(rng));
+	switch (rng.below(8)) {
+		case 0: case 1: col.g = col.r; col.b = col.r; break;
+		case 2: col.g = col.r; break;
+		case 3: col.b = col.g; break;
+		default: break;
+	}
+	return col;
+}
+
+// channels partially out of [0, 1]
+nk::colorf random_colorf(test::random& rng)
+{
+	nk::colorf col(random_float(rng, -0.5f, 1.5f), random_float(rng, -0.5f, 1.5f),
+		random_float(rng, -0.5f, 1.5f), random_float(rng, -0.5f, 1.5f));
+	switch (rng.below(8)) {
+		case 0: col.g = col.r; col.b = col.r; break;
+		case 1: col.r = random_float(rng, 0.0f, 1.0f); col.g = col.r; col.b = col.r; break;
+		case 2: col.b = col.g; break;
+		case 3: col.r = 1000.0f; col.a = -1000.0f; break;
+		default: break;
+	}
+	return col;
+}
+
+// includes zero and negative saturation and hue at and past the end of its range
+nk::colorf_hsva random_colorf_hsva(test::random& rng)
+{
+	nk::colorf_hsva col(random_float(rng, 0.0f, 1.0f), random_float(rng, 0.0f, 1.0f),
+		random_float(rng, 0.0f, 1.0f), random_float(rng, 0.0f, 1.0f));
+	switch (rng.below(8)) {
+		case 0: col.s = 0.0f; break;
+		case 1: col.s = -0.5f; break;
+		case 2: col.h = 1.0f; break;
+		case 3: col.h = random_float(rng, -0.5f, 1.5f); col.v = random_float(rng, -0.5f, 1.5f); break;
+		default: break;
+	}
+	return col;
+}
+
+nk::color_hsva random_color_hsva(test::random& rng)
+{
+	nk::color_hsva col(random_byte(rng), random_byte(rng), random_byte(rng), random_byte(rng));
+	if (rng.below(4) == 0)
+		col.s = 0;
+	return col;
+}
+
+// Runs the batch conversion on inputs of all sizes and compares every result with the single-value conversion.
+// The output has one more element (a converted random color, unlike padding of the last block) which must stay untouched.
+template <typename In, typename Out, typename Generate, typename Batch, typename Single, typename Compare>
+void compare(test::random& rng, Generate generate, Batch batch, Single single, Compare compare_results)
+{
+	for (const int size : sizes) {
+		std::vector<In> input;
+		for (int i = 0; i < size; ++i)
+			input.push_back(generate(rng));
+
+		const Out guard = single(generate(rng));
+		std::vector<Out> output(static_cast<std::size_t>(size + 1), guard);
+		batch(nk::span<const In>(input.data(), size), nk::span<Out>(output.data(), size));
+
+		for (int i = 0; i < size; ++i) {
+			const auto index = static_cast<std::size_t>(i);
+			TEST_CHECK(compare_results(output[index], single(input[index])));
+		}
+		TEST_CHECK(compare_results(output.back(), guard));
+	}
+}
+
+void test_rgba_rgbaf()
+{
+	test::random rng(1);
+	compare<nk::color, nk::colorf>(rng, &random_color,
+		[](nk::span<const nk::color> in, nk::span<nk::colorf> out) { nk::rgba_to_rgbaf(in, out); },
+		[](nk::color col) { return nk::rgba_to_rgbaf(col); },
+		[](nk::colorf lhs, nk::colorf rhs) { return equal(lhs, rhs); });
+	compare<nk::colorf, nk::color>(rng, &random_colorf,
+		[](nk::span<const nk::colorf> in, nk::span<nk::color> out) { nk::rgbaf_to_rgba(in, out); },
+		[](nk::colorf col) { return nk::rgbaf_to_rgba(col); },
+		[](nk::color lhs, nk::color rhs) { return equal(lhs, rhs); });
+}
+
+void test_rgbaf_hsvaf()
+{
+	test::random rng(2);
+	compare<nk::colorf, nk::colorf_hsva>(rng, &random_colorf,
+		[](nk::span<const nk::colorf> in, nk::span<nk::colorf_hsva> out) { nk::rgbaf_to_hsvaf(in, out); },
+		[](nk::colorf col) { return nk::rgbaf_to_hsvaf(col); },
+		[](nk::colorf_hsva lhs, nk::colorf_hsva rhs) { return close(lhs, rhs); });
+	compare<nk::colorf_hsva, nk::colorf>(rng, &random_colorf_hsva,
+		[](nk::span<const nk::colorf_hsva> in, nk::span<nk::colorf> out) { nk::hsvaf_to_rgbaf(in, out); },
+		[](nk::colorf_hsva col) { return nk::hsvaf_to_rgbaf(col); },
+		[](nk::colorf lhs, nk::colorf rhs) { return close(lhs, rhs); });
+}
+
+void test_rgba_hsvaf()
+{
+	test::random rng(3);
+	compare<nk::color, nk::colorf_hsva>(rng, &random_color,
+		[](nk::span<const nk::color> in, nk::span<nk::colorf_hsva> out) { nk::rgba_to_hsvaf(in, out); },
+		[](nk::color col) { return nk::rgba_to_hsvaf(col); },
+		[](nk::colorf_hsva lhs, nk::colorf_hsva rhs) { return close(lhs, rhs); });
+	compare<nk::colorf_hsva, nk::color>(rng, &random_colorf_hsva,
+		[](nk::span<const nk::colorf_hsva> in, nk::span<nk::color> out) { nk::hsvaf_to_rgba(in, out); },
+		[](nk::colorf_hsva col) { return nk::hsvaf_to_rgba(col); },
+		[](nk::color lhs, nk::color rhs) { return close(lhs, rhs); });
+}
+
+void test_rgba_hsva()
+{
+	test::random rng(4);
+	compare<nk::color, nk::color_hsva>(rng, &random_color,
+		[](nk::span<const nk::color> in, nk::span<nk::color_hsva> out) { nk::rgba_to_hsva(in, out); },
+		[](nk::color col) { return nk::rgba_to_hsva(col); },
+		[](nk::color_hsva lhs, nk::color_hsva rhs) { return close(lhs, rhs); });
+	compare<nk::color_hsva, nk::color>(rng, &random_color_hsva,
+		[](nk::span<const nk::color_hsva> in, nk::span<nk::color> out) { nk::hsva_to_rgba(in, out); },
+		[](nk::color_hsva col) { return nk::hsva_to_rgba(col); },
+		[](nk::color lhs, nk::color rhs) { return close(lhs, rhs); });
+}
+
+// the in-place overloads, adapted to the input/output form of compare
+void test_premultiply_alpha()
+{
+	test::random rng(5);
+	compare<nk::color, nk::color>(rng, &random_color,
+		[](nk::span<const nk::color> in, nk::span<nk::color> out) {
+			for (int i = 0; i < in.size(); ++i)
+				out[i] = in[i];
+			nk::premultiply_alpha(out);
+		},
+		[](nk::color col) { return nk::premultiply_alpha(col); },
+		[](nk::color lhs, nk::color rhs) { return equal(lhs, rhs); });
+	compare<nk::colorf, nk::colorf>(rng, &random_colorf,
+		[](nk::span<const nk::colorf> in, nk::span<nk::colorf> out) {
+			for (int i = 0; i < in.size(); ++i)
+				out[i] = in[i];
+			nk::premultiply_alpha(out);
+		},
+		[](nk::colorf col) { return nk::premultiply_alpha(col); },
+		[](nk::colorf lhs, nk::colorf rhs) { return equal(lhs, rhs); });
+}
+
+void test_u32()
+{
+	test::random rng(6);
+	compare<nk::color, nk_uint>(rng, &random_color,
+		[](nk::span<const nk::color> in, nk::span<nk_uint> out) { nk::rgba_to_u32(in, out); },
+		[](nk::color col) { return col.to_u32(); },
+		[](nk_uint lhs, nk_uint rhs) { return lhs == rhs; });
+	compare<nk_uint, nk::color>(rng, [](test::random& r) { return static_cast<nk_uint>(r.next()); },
+		[](nk::span<const nk_uint> in, nk::span<nk::color> out) { nk::u32_to_rgba(in, out); },
+		[](nk_uint rgba) { return nk::color::from_rgba(rgba); },
+		[](nk::color lhs, nk::color rhs) { return equal(lhs, rhs); });
+}
+
+}
+
+int main()
+{
+	test_rgba_rgbaf();
+	test_rgbaf_hsvaf();
+	test_rgba_hsvaf();
+	test_rgba_hsva();
+	test_premultiply_alpha();
+	test_u32();
+	return test::result();
+}
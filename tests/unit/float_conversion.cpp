@@ -0,0 +1,218 @@
+// Tests of Nukleus' string <=> double conversions (used when NK_STRTOD and NK_DTOA are not defined).
+// The functions exist only in the implementation mode, so this test is its own implementation TU.
+// The reference is the standard library (in the "C" locale), which is correctly rounded on all tested platforms.
+
+#define NK_IMPLEMENTATION
+#include "test_common.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::uint64_t to_bits(double value)
+{
+	std::uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+double from_bits(std::uint64_t bits)
+{
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+bool same_parse(const std::string& text)
+{
+	char* end_expected = nullptr;
+	char* end_actual = nullptr;
+	const double expected = std::strtod(text.c_str(), &end_expected);
+	const double actual = nk::detail::fp::parse(text.c_str(), &end_actual);
+	const bool result = to_bits(expected) == to_bits(actual) && end_expected == end_actual;
+	if (!result)
+		std::printf("parse mismatch for %.60s (%zu characters)\n", text.c_str(), text.size());
+
+	return result;
+}
+
+// exact decimal representation of unsigned integers, least significant digit first
+using decimal = std::vector<int>;
+
+void multiply(decimal& number, int factor)
+{
+	int carry = 0;
+	for (int& digit : number) {
+		const int value = digit * factor + carry;
+		digit = value % 10;
+		carry = value / 10;
+	}
+
+	for (; carry != 0; carry /= 10)
+		number.push_back(carry % 10);
+}
+
+// exact decimal string of the midpoint between the positive finite double with given bits and the next one
+std::string midpoint_string(std::uint64_t bits)
+{
+	const int biased_e = static_cast<int>(bits >> 52);
+	const std::uint64_t significand = biased_e != 0 ? (bits & 0x000FFFFFFFFFFFFFull) | 0x0010000000000000ull : bits;
+	const int binary_e = (biased_e != 0 ? biased_e : 1) - 1075 - 1;
+
+	// midpoint = (2 * significand + 1) * 2^binary_e = (2 * significand + 1) * 5^-binary_e / 10^-binary_e
+	decimal number;
+	for (std::uint64_t m = 2 * significand + 1; m != 0; m /= 10)
+		number.push_back(static_cast<int>(m % 10));
+
+	for (int i = 0; i < (binary_e < 0 ? -binary_e : binary_e); ++i)
+		multiply(number, binary_e < 0 ? 5 : 2);
+
+	std::string result;
+	for (auto it = number.rbegin(); it != number.rend(); ++it)
+		result += static_cast<char>('0' + *it);
+
+	if (binary_e < 0)
+		result += "e-" + std::to_string(-binary_e);
+
+	return result;
+}
+
+std::uint64_t random_finite_bits(test::random& rng)
+{
+	for (;;) {
+		const std::uint64_t bits = (static_cast<std::uint64_t>(rng.next()) << 32 | rng.next()) & 0x7FFFFFFFFFFFFFFFull;
+		// largest double excluded - its midpoint with infinity is not a number
+		if ((bits >> 52) < 0x7FE)
+			return bits;
+	}
+}
+
+void test_parse_simple()
+{
+	const char* const inputs[] = {
+		"0", "-0", "0.0", "1", "-1", ".5", "5.", "0.1", "0.3", "3.14159", "1e10", "1E-10", "+2.5e+3",
+		"123456789012345678901234567890", "0.000000000000000000000000000000000000001",
+		"9007199254740993", "9007199254740993.0000000000000000000000000001",
+		"1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "1e309",
+		"2.2250738585072011e-308", "2.2250738585072014e-308", "4.9e-324", "2.4703282292062328e-324",
+		"2.4703282292062327e-324", "1e-400", "1e100000000", "1e-100000000",
+		"inf", "-Infinity", "nan", "  42", "12abc", "1e", "1e+", "abc", "", ".", "-.e1"
+	};
+
+	for (const char* input : inputs)
+		TEST_CHECK(same_parse(input));
+}
+
+// inputs exactly at, just below and just above rounding boundaries are resolved by exact arithmetic
+void test_parse_midpoints()
+{
+	test::random rng(30);
+	for (int i = 0; i < 2000; ++i) {
+		const std::string midpoint = midpoint_string(random_finite_bits(rng));
+		const std::size_t exponent = midpoint.find('e');
+		const std::string digits = midpoint.substr(0, exponent);
+		const std::string suffix = exponent == std::string::npos ? std::string() : midpoint.substr(exponent);
+
+		TEST_CHECK(same_parse(midpoint));
+		TEST_CHECK(same_parse(digits + ".0000000000000000000000000000001" + suffix));
+
+		// midpoint minus one unit in the last digit followed by 9s
+		std::string below = digits;
+		std::size_t pos = below.size() - 1;
+		while (below[pos] == '0')
+			below[pos--] = '9';
+		--below[pos];
+		TEST_CHECK(same_parse(below + ".999999999999999999999999999999" + suffix));
+	}
+}
+
+void test_parse_random_digits()
+{
+	test::random rng(31);
+	for (int i = 0; i < 20000; ++i) {
+		std::string text = rng.below(2) ? "-" : "";
+		const int digits = 1 + rng.below(40);
+		const int point = rng.below(digits + 1);
+		for (int d = 0; d < digits; ++d) {
+			if (d == point)
+				text += '.';
+			text += static_cast<char>('0' + rng.below(10));
+		}
+
+		text += 'e' + std::to_string(rng.below(700) - 350);
+		TEST_CHECK(same_parse(text));
+	}
+}
+
+// digits without leading and trailing zeros
+int significant_digits(const char* text)
+{
+	int count = 0;
+	int trailing_zeros = 0;
+	for (const char* p = text; *p; ++p) {
+		if (*p < '0' || *p > '9' || (count == 0 && *p == '0'))
+			continue;
+
+		++count;
+		trailing_zeros = *p == '0' ? trailing_zeros + 1 : 0;
+	}
+
+	return count - trailing_zeros;
+}
+
+// Grisu2 output round-trips and is the shortest in almost all cases - otherwise it is 1 or 2 digits longer
+void test_write_round_trip()
+{
+	test::random rng(32);
+	int not_shortest = 0;
+	constexpr int count = 20000;
+	for (int i = 0; i < count; ++i) {
+		const double value = from_bits(random_finite_bits(rng));
+
+		// large enough for any double in fixed notation
+		char buffer[1100];
+		nk::detail::fp::write_fixed(buffer, static_cast<int>(sizeof(buffer)), value);
+		TEST_CHECK(to_bits(std::strtod(buffer, nullptr)) == to_bits(value));
+
+		char shortest[32];
+		int precision = 1;
+		for (; precision < 17; ++precision) {
+			std::snprintf(shortest, sizeof(shortest), "%.*e", precision - 1, value);
+			if (to_bits(std::strtod(shortest, nullptr)) == to_bits(value))
+				break;
+		}
+
+		const int significant = significant_digits(buffer);
+		TEST_CHECK(significant <= 17);
+		if (significant > precision)
+			++not_shortest;
+	}
+
+	TEST_CHECK(not_shortest < count / 100);
+}
+
+void test_write_truncated()
+{
+	char buffer[8];
+	nk::detail::fp::write_fixed(buffer, static_cast<int>(sizeof(buffer)), 123456789.0);
+	TEST_CHECK(std::strcmp(buffer, "1234567") == 0);
+
+	nk::detail::fp::write_fixed(buffer, static_cast<int>(sizeof(buffer)), -0.0);
+	TEST_CHECK(std::strcmp(buffer, "-0") == 0);
+}
+
+}
+
+int main()
+{
+	test_parse_simple();
+	test_parse_midpoints();
+	test_parse_random_digits();
+	test_write_round_trip();
+	test_write_truncated();
+	return test::result();
+}
@@ -0,0 +1,115 @@
+// Tests of cached groups: when recorded commands are replayed and when the group has to be built again.
+
+#include "test_common.hpp"
+
+namespace {
+
+float text_width(nk_handle, float, const char*, int len)
+{
+	return 8.0f * static_cast<float>(len);
+}
+
+// the group occupies approximately [4, 396] x [4, 104] of the window
+constexpr int inside_x = 50;
+constexpr int inside_y = 50;
+constexpr int outside_x = 350;
+constexpr int outside_y = 250;
+
+class fixture
+{
+public:
+	fixture()
+	: m_ctx(nk::context::init_default(m_font))
+	{}
+
+	// one frame with the mouse at given position; returns whether the group contents have been built
+	bool frame(int mouse_x, int mouse_y, bool left_down = false)
+	{
+		{
+			auto input = m_ctx.input_scoped();
+			input.motion(mouse_x, mouse_y);
+			input.button(nk::buttons::left, mouse_x, mouse_y, left_down);
+		}
+
+		bool built = false;
+		if (auto win = m_ctx.window_scoped("window", {0, 0, 400, 300}, nk::window_flags::none)) {
+			auto row = win.layout_row_dynamic(100, 1);
+			if (auto group = row.cached_group_scoped(m_cache, "group", 1, 1)) {
+				built = true;
+				win.layout_row_dynamic(30, 1);
+				static_cast<void>(win.button_label("button"));
+			}
+		}
+
+		m_ctx.clear();
+		return built;
+	}
+
+	const nk::group_cache& cache() const { return m_cache; }
+
+private:
+	static nk_user_font make_font()
+	{
+		nk_user_font font = {};
+		font.height = 13.0f;
+		font.width = &text_width;
+		return font;
+	}
+
+	nk_user_font m_font = make_font();
+	nk::context m_ctx;
+	nk::group_cache m_cache{nk::buffer::init_default()};
+};
+
+void test_replay_without_mouse()
+{
+	fixture f;
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(f.cache().is_valid());
+	TEST_CHECK(!f.frame(outside_x, outside_y));
+	TEST_CHECK(!f.frame(outside_x, outside_y));
+}
+
+// commands recorded with a hovered button must not be replayed after the mouse leaves
+void test_rebuild_after_hover()
+{
+	fixture f;
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(!f.frame(outside_x, outside_y));
+
+	TEST_CHECK(f.frame(inside_x, inside_y));
+	TEST_CHECK(!f.cache().is_valid());
+
+	// the previous mouse position is still over the group
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(!f.cache().is_valid());
+
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(f.cache().is_valid());
+	TEST_CHECK(!f.frame(outside_x, outside_y));
+}
+
+// a button pressed on the group keeps it active even when the mouse is dragged away
+void test_rebuild_while_pressed()
+{
+	fixture f;
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(f.frame(inside_x, inside_y, true));
+	TEST_CHECK(f.frame(outside_x, outside_y, true));
+	TEST_CHECK(f.frame(outside_x, outside_y, true));
+	TEST_CHECK(!f.cache().is_valid());
+
+	TEST_CHECK(f.frame(outside_x, outside_y));
+	TEST_CHECK(f.cache().is_valid());
+	TEST_CHECK(!f.frame(outside_x, outside_y));
+}
+
+}
+
+int main()
+{
+	test_replay_without_mouse();
+	test_rebuild_after_hover();
+	test_rebuild_while_pressed();
+	return test::result();
+}
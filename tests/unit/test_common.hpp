@@ -0,0 +1,61 @@
+#pragma once
+
+#include <nukleus.hpp>
+
+#include <cstdio>
+#include <cstdint>
+
+// Minimal checking facility, tests are plain executables registered in CTest.
+// A test passes when main returns 0 - return test::result() at its end.
+
+namespace test {
+
+inline int& failures()
+{
+	static int count = 0;
+	return count;
+}
+
+inline bool check(bool condition, const char* expression, const char* file, int line)
+{
+	if (!condition) {
+		std::printf("%s:%d: check failed: %s\n", file, line, expression);
+		++failures();
+	}
+
+	return condition;
+}
+
+inline int result()
+{
+	if (failures() != 0)
+		std::printf("%d check(s) failed\n", failures());
+
+	return failures() == 0 ? 0 : 1;
+}
+
+// deterministic pseudo-random numbers so that failures are reproducible
+class random
+{
+public:
+	explicit random(std::uint64_t seed) : m_state(seed) {}
+
+	std::uint32_t next()
+	{
+		m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+		return static_cast<std::uint32_t>(m_state >> 33);
+	}
+
+	// in range [0, n)
+	int below(int n)
+	{
+		return static_cast<int>(next() % static_cast<std::uint32_t>(n));
+	}
+
+private:
+	std::uint64_t m_state;
+};
+
+}
+
+#define TEST_CHECK(...) test::check(static_cast<bool>(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
@@ -0,0 +1,165 @@
+// Differential tests of UTF-8 functions (which have an ASCII fast path) against Nuklear's decoder.
+
+#include "test_common.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// reference implementation of utf8_decode_all - Nuklear's decoder in a loop
+int reference_decode_all(const char* utf8, int byte_len, nk::rune* codepoints, int max_codepoints, int& bytes_consumed)
+{
+	int count = 0;
+	int pos = 0;
+	while (pos < byte_len && count < max_codepoints) {
+		const int glyph_len = nk_utf_decode(utf8 + pos, &codepoints[count], byte_len - pos);
+		if (glyph_len == 0)
+			break;
+
+		++count;
+		pos += glyph_len;
+	}
+
+	bytes_consumed = pos;
+	return count;
+}
+
+void compare_decode(const std::string& text)
+{
+	const char* const utf8 = text.data();
+	const int byte_len = static_cast<int>(text.size());
+
+	for (int pos = 0; pos <= byte_len; ++pos) {
+		nk::rune expected = 0;
+		nk::rune actual = 0;
+		const int expected_len = nk_utf_decode(utf8 + pos, &expected, byte_len - pos);
+		const int actual_len = nk::utf8_decode(utf8 + pos, byte_len - pos, actual);
+		TEST_CHECK(actual_len == expected_len);
+		if (expected_len != 0)
+			TEST_CHECK(actual == expected);
+	}
+}
+
+void compare_len(const std::string& text)
+{
+	const char* const utf8 = text.data();
+	const int byte_len = static_cast<int>(text.size());
+
+	for (int len = 0; len <= byte_len; ++len)
+		TEST_CHECK(nk::utf8_len(utf8, len) == nk_utf_len(utf8, len));
+}
+
+void compare_at(const std::string& text)
+{
+	const char* const utf8 = text.data();
+	const int byte_len = static_cast<int>(text.size());
+	const int glyphs = nk_utf_len(utf8, byte_len);
+
+	for (int index = 0; index <= glyphs + 1; ++index) {
+		nk::rune expected = 0;
+		nk::rune actual = 0;
+		int expected_len = -1;
+		int actual_len = -1;
+		const char* const expected_ptr = nk_utf_at(utf8, byte_len, index, &expected, &expected_len);
+		const char* const actual_ptr = nk::utf8_at(utf8, byte_len, index, actual, actual_len);
+		TEST_CHECK(actual_ptr == expected_ptr);
+		TEST_CHECK(actual_len == expected_len);
+		TEST_CHECK(actual == expected);
+	}
+}
+
+void compare_decode_all(const std::string& text)
+{
+	const char* const utf8 = text.data();
+	const int byte_len = static_cast<int>(text.size());
+
+	std::vector<nk::rune> expected(text.size() + 1);
+	std::vector<nk::rune> actual(text.size() + 1);
+	// different output sizes, to stop inside and at the end of ASCII runs
+	for (int max = 0; max <= byte_len + 1; max = max < 20 ? max + 1 : max * 2) {
+		int expected_consumed = -1;
+		int actual_consumed = -1;
+		const int expected_count = reference_decode_all(utf8, byte_len, expected.data(), max, expected_consumed);
+		const int actual_count = nk::utf8_decode_all(utf8, byte_len, actual.data(), max, &actual_consumed);
+		TEST_CHECK(actual_count == expected_count);
+		TEST_CHECK(actual_consumed == expected_consumed);
+		for (int i = 0; i < expected_count && i < actual_count; ++i)
+			TEST_CHECK(actual[static_cast<std::size_t>(i)] == expected[static_cast<std::size_t>(i)]);
+	}
+}
+
+void compare_all(const std::string& text)
+{
+	compare_decode(text);
+	compare_len(text);
+	compare_at(text);
+	compare_decode_all(text);
+}
+
+// pieces of text exercising the boundaries of the fast path
+const char* const pieces[] = {
+	"a", "Z", " ", "\x01", "\x7E",
+	"\x7F",                     // DEL: ASCII but decoded by Nuklear as invalid
+	"\xC3\xA9",                 // U+00E9
+	"\xDF\xBF",                 // U+07FF
+	"\xE2\x82\xAC",             // U+20AC
+	"\xEF\xBF\xBF",             // U+FFFF
+	"\xF0\x9F\x98\x80",         // U+1F600
+	"\x80",                     // lone continuation byte
+	"\xC3",                     // truncated 2-byte sequence
+	"\xE2\x82",                 // truncated 3-byte sequence
+	"\xC0\xAF",                 // overlong encoding
+	"\xED\xA0\x80",             // surrogate
+	"\xFF",                     // never valid in UTF-8
+};
+
+std::string ascii_run(int length)
+{
+	std::string result;
+	for (int i = 0; i < length; ++i)
+		result += static_cast<char>('a' + i % 26);
+
+	return result;
+}
+
+void test_handpicked()
+{
+	compare_all("");
+	compare_all("ascii only");
+	compare_all("\x7F");
+	compare_all(ascii_run(15) + "\x7F");
+	compare_all(ascii_run(16) + "\x7F" + ascii_run(16));
+
+	// multi-byte sequences just before, at and after 16-byte block boundaries
+	for (const char* piece : pieces)
+		for (int prefix = 0; prefix <= 34; ++prefix)
+			compare_all(ascii_run(prefix) + piece + ascii_run(prefix % 7));
+}
+
+void test_random()
+{
+	test::random rng(2024);
+	constexpr int piece_count = static_cast<int>(sizeof(pieces) / sizeof(pieces[0]));
+	for (int iteration = 0; iteration < 2000; ++iteration) {
+		std::string text;
+		const int parts = rng.below(8);
+		for (int i = 0; i < parts; ++i) {
+			if (rng.below(2) == 0)
+				text += ascii_run(rng.below(40));
+			else
+				text += pieces[rng.below(piece_count)];
+		}
+
+		compare_all(text);
+	}
+}
+
+}
+
+int main()
+{
+	test_handpicked();
+	test_random();
+	return test::result();
+}